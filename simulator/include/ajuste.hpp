@@ -0,0 +1,45 @@
+#ifndef AJUSTE_HPP
+#define AJUSTE_HPP
+
+#include "types.hpp"
+#include <vector>
+#include <string>
+#include <optional>
+
+// Busca automática da quantidade de unidades (UNITS/MEM_UNITS/VUNITS) sob um orçamento de hardware.
+// Cada tipo usado pelo traço tem um peso (COST, padrão 1) e o custo de uma configuração é a soma
+// quantidade x peso, limitada por BUDGET. Uma busca evolutiva com mutações de subida de encosta
+// (+1/-1 em um tipo, ou troca de uma unidade entre dois tipos) avalia cada geração em paralelo e
+// guarda em cache as configurações já simuladas. O resultado é a fronteira de Pareto ciclos x custo.
+
+struct ParametrosAjuste {
+    int geracoes = 30;
+    int populacao = 16;
+    unsigned semente = 1;
+};
+
+struct ConfiguracaoAvaliada {
+    std::vector<int> unidades; // quantidade por tipo, na ordem de ResultadoAjuste::tipos
+    int custo = 0;
+    int ciclos = 0;
+    bool terminou = false;
+};
+
+struct ResultadoAjuste {
+    std::vector<std::string> tipos;  // tipos de unidade usados pelo traço
+    std::vector<int> custos;         // peso de cada tipo
+    int orcamento = 0;
+    std::optional<ConfiguracaoAvaliada> configuracaoOriginal; // a do arquivo, se couber no orçamento
+    std::vector<ConfiguracaoAvaliada> fronteiraPareto;         // ordenada por custo crescente
+    int avaliacoes = 0;   // simulações executadas
+    int acertosCache = 0; // candidatos que já tinham sido simulados
+    int threadsUsadas = 0;
+    double segundos = 0.0;
+};
+
+ResultadoAjuste ajustaUnidades(const ConfigSimulador& config, const std::vector<InstrucaoInput>& instrucoes,
+                               const ParametrosAjuste& parametros);
+
+void imprimeResultadoAjuste(const ResultadoAjuste& resultado);
+
+#endif
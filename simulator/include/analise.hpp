@@ -0,0 +1,32 @@
+#ifndef ANALISE_HPP
+#define ANALISE_HPP
+
+#include "estado.hpp"
+#include <map>
+#include <string>
+#include <vector>
+
+struct LimiteRecurso { // limite inferior imposto por um tipo de unidade funcional
+    int instrucoes = 0;      // instruções do traço que usam este tipo
+    int unidades = 0;        // unidades configuradas (UNITS/MEM_UNITS)
+    long long ocupacao = 0;  // soma dos ciclos em que cada instrução ocupa a estação (issue até write, inclusive)
+    long long ciclos = 0;    // ocupacao / unidades, arredondado para cima (0 unidades: sem limite válido)
+};
+
+struct ResultadoAnalise {
+    int numInstrucoes = 0;
+    long long caminhoCritico = 0;             // ciclos da maior cadeia RAW com recursos ilimitados
+    std::vector<int> instrucoesCaminhoCritico; // posições das instruções da cadeia crítica
+    double ipcIdeal = 0.0;                    // numInstrucoes / caminhoCritico
+    long long limiteEmissao = 0;              // uma emissão por ciclo: a última instrução é emitida no ciclo N
+    long long limiteCDB = 0;                  // escritas por ciclo limitadas por CDB (0 = barramento ilimitado)
+    std::map<std::string, LimiteRecurso> limitesRecurso;
+    std::string recursoLimitante;
+    long long limiteInferior = 0;             // maior dos limites acima
+};
+
+ResultadoAnalise analisaTraco(const Estado& estado); // passagem O(N) sobre o traço decodificado
+
+void imprimeAnalise(const ResultadoAnalise& analise, int ciclos_simulados); // limites ao lado dos ciclos simulados
+
+#endif
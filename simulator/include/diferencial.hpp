@@ -0,0 +1,153 @@
+#ifndef DIFERENCIAL_HPP
+#define DIFERENCIAL_HPP
+
+#include "types.hpp"
+#include "estado.hpp"
+#include "estado_smt.hpp"
+#include "simulador.hpp"
+#include <functional>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+// Verificação diferencial ciclo a ciclo entre o Estado (referência) e um motor candidato.
+// O candidato é construído com (const ConfigSimulador&, const std::vector<InstrucaoInput>&) e observado
+// pelas sobrecargas abaixo: avancaCiclo executa um ciclo, estadoObservavel dá acesso às instruções e
+// ao relógio, e registradoresObservaveis à tabela de status de registradores.
+
+inline bool avancaCiclo(Estado& motor) { return motor.executa_ciclo(); }
+
+template <typename Observador>
+bool avancaCiclo(Simulador<Observador>& motor) { // caminho da biblioteca: step() em vez de executa_ciclo()
+    motor.step(1);
+    return motor.terminou();
+}
+
+inline const Estado& estadoObservavel(const Estado& motor) { return motor; }
+
+template <typename Observador>
+const Estado& estadoObservavel(const Simulador<Observador>& motor) { return motor.motor(); }
+
+inline const TabelaRegistradores& registradoresObservaveis(const Estado& motor) { return motor.estacaoRegistradores; }
+
+inline const TabelaRegistradores& registradoresObservaveis(const EstadoSMT& motor) { return motor.threads.at(0).estacaoRegistradores; }
+
+template <typename Observador>
+const TabelaRegistradores& registradoresObservaveis(const Simulador<Observador>& motor) { return motor.motor().estacaoRegistradores; }
+
+class EstadoSMTUmaThread : public EstadoSMT { // SMT com um único traço: deve se comportar exatamente como o Estado
+public:
+    EstadoSMTUmaThread(const ConfigSimulador& cfg, const std::vector<InstrucaoInput>& instrucoes)
+        : EstadoSMT(cfg, {instrucoes}, PoliticaEmissao::RoundRobin) {}
+};
+
+struct Divergencia { // primeira diferença encontrada entre os dois motores
+    int ciclo = 0;
+    std::string descricao;
+};
+
+struct CasoTeste {
+    ConfigSimulador config;
+    std::vector<InstrucaoInput> instrucoes;
+};
+
+using PredicadoFalha = std::function<bool(const CasoTeste&)>; // true se o caso ainda reproduz a divergência
+
+CasoTeste geraCasoAleatorio(std::mt19937& rng, int max_instrucoes); // traço e configuração aleatórios
+
+CasoTeste geraCasoLaco(std::mt19937& rng, int max_instrucoes); // corpo aleatório terminado em BNEZ e repetido várias vezes
+
+using GeradorCasos = std::function<CasoTeste(std::mt19937&, int)>;
+
+CasoTeste reduzCaso(const CasoTeste& caso, const PredicadoFalha& falha); // encolhe o caso mantendo a falha
+
+std::string descreveTempo(const std::optional<int>& ciclo);
+
+template <typename Referencia, typename Candidato>
+std::optional<Divergencia> comparaEmLockstep(const CasoTeste& caso) { // executa os dois motores ciclo a ciclo e compara o estado observável
+    Referencia referencia(caso.config, caso.instrucoes);
+    Candidato candidato(caso.config, caso.instrucoes);
+    const Estado& ref = estadoObservavel(referencia);
+    const Estado& cand = estadoObservavel(candidato);
+    const int limite_ciclos = ref.limiteCiclosSeguro();
+
+    bool ref_terminou = ref.instrucoesEscritas >= ref.estadoInstrucoes.size();
+    bool cand_terminou = cand.instrucoesEscritas >= cand.estadoInstrucoes.size();
+    while (!(ref_terminou && cand_terminou) && ref.clock_cycle < limite_ciclos) {
+        if (!ref_terminou) ref_terminou = avancaCiclo(referencia);
+        if (!cand_terminou) cand_terminou = avancaCiclo(candidato);
+
+        const int ciclo = ref.clock_cycle;
+        if (ref_terminou != cand_terminou || cand.clock_cycle != ciclo) {
+            return Divergencia{ciclo, "termino: referencia " + std::string(ref_terminou ? "terminou" : "executando") +
+                                      " no ciclo " + std::to_string(ciclo) + ", candidato " +
+                                      (cand_terminou ? "terminou" : "executando") + " no ciclo " +
+                                      std::to_string(cand.clock_cycle)};
+        }
+
+        if (ref.estadoInstrucoes.size() != cand.estadoInstrucoes.size()) {
+            return Divergencia{ciclo, "numero de instrucoes diferente"};
+        }
+        for (size_t i = 0; i < ref.estadoInstrucoes.size(); ++i) {
+            const auto& r = ref.estadoInstrucoes[i];
+            const auto& c = cand.estadoInstrucoes[i];
+            const std::pair<const char*, std::pair<std::optional<int>, std::optional<int>>> campos[] = {
+                {"issue", {r.issue, c.issue}},
+                {"exeCompleta", {r.exeCompleta, c.exeCompleta}},
+                {"write", {r.write, c.write}},
+            };
+            for (const auto& campo : campos) {
+                if (campo.second.first != campo.second.second) {
+                    return Divergencia{ciclo, "instrucao " + std::to_string(i) + " (" + r.instrucao.operacao + ") campo " +
+                                              campo.first + ": referencia " + descreveTempo(campo.second.first) +
+                                              ", candidato " + descreveTempo(campo.second.second)};
+                }
+            }
+        }
+
+        const TabelaRegistradores& ref_registradores = registradoresObservaveis(referencia);
+        const TabelaRegistradores& cand_registradores = registradoresObservaveis(candidato);
+        if (ref_registradores != cand_registradores) {
+            for (const auto& pair : ref_registradores) {
+                auto it = cand_registradores.find(pair.first);
+                if (it == cand_registradores.end() || it->second != pair.second) {
+                    std::string cand_valor = it == cand_registradores.end() ? "ausente" : it->second.value_or("init");
+                    return Divergencia{ciclo, "registrador " + pair.first + ": referencia " + pair.second.value_or("init") +
+                                              ", candidato " + cand_valor};
+                }
+            }
+            return Divergencia{ciclo, "estacaoRegistradores com registradores extras no candidato"};
+        }
+    }
+
+    // o limite é folgado para qualquer traço válido: se um dos motores não terminou, há um travamento
+    if (!ref_terminou || !cand_terminou) {
+        return Divergencia{ref.clock_cycle, "limite de " + std::to_string(limite_ciclos) + " ciclos atingido sem terminar (referencia " +
+                                            (ref_terminou ? "terminou" : "executando") + ", candidato " +
+                                            (cand_terminou ? "terminou" : "executando") + ")"};
+    }
+    return std::nullopt;
+}
+
+struct ResultadoDiferencial {
+    int casosExecutados = 0;
+    std::optional<CasoTeste> casoMinimo;
+    std::optional<Divergencia> divergencia; // divergência do caso mínimo
+};
+
+using ComparadorMotores = std::function<std::optional<Divergencia>(const CasoTeste&)>; // std::nullopt se os motores concordam
+
+ResultadoDiferencial executaVerificacaoDiferencial(int num_casos, unsigned semente, int max_instrucoes,
+                                                   const ComparadorMotores& compara, const GeradorCasos& gera = geraCasoAleatorio);
+
+// o regime permanente (executaComExtrapolacao) não avança ciclo a ciclo: compara só o resultado final
+// com o de uma simulação completa, em traços de laço gerados por geraCasoLaco
+std::optional<Divergencia> comparaRegimeComCompleto(const CasoTeste& caso);
+
+template <typename Referencia, typename Candidato>
+ResultadoDiferencial verificaDiferencial(int num_casos, unsigned semente, int max_instrucoes = 24) { // casos aleatórios até a primeira divergência, que é reduzida
+    return executaVerificacaoDiferencial(num_casos, semente, max_instrucoes, comparaEmLockstep<Referencia, Candidato>);
+}
+
+#endif
@@ -7,6 +7,8 @@
 #include <string>
 #include <optional>
 
+using TabelaRegistradores = std::map<std::string, std::optional<std::string>>; // registrador -> estação que produzirá seu valor
+
 class Estado {
 public:
     ConfigSimulador config;
@@ -14,25 +16,39 @@ public:
     std::map<std::string, UnidadeFuncional> unidadesFuncionais;
     std::map<std::string, UnidadeFuncionalMemoria> unidadesFuncionaisMemoria;
     int clock_cycle;
-    std::map<std::string, std::optional<std::string>> estacaoRegistradores; // para qual estação os registradores estão apontando?
+    size_t proximaEmissao = 0; // índice da primeira instrução ainda não emitida (a emissão é em ordem)
+    size_t instrucoesEscritas = 0; // quantas instruções já escreveram seu resultado
+    int conflitosCDB = 0; // escritas adiadas por falta de barramento (uma por unidade a cada ciclo de espera)
+    std::vector<int> registradorComprimentoVetor; // VLR de cada thread (uma só fora do modo SMT)
+    TabelaRegistradores estacaoRegistradores; // para qual estação os registradores estão apontando?
 
     Estado(const ConfigSimulador& cfg, const std::vector<InstrucaoInput>& instrucoes_input); // inicialização das instruções, registradores e unidades funcionais
 
+    virtual ~Estado() = default;
+
     EstadoInstrucao* getNovaInstrucao(); // retorna a próxima instrução que ainda foi emitida 
 
-    std::string verificaUFInstrucao(const InstrucaoDetalhes& instr_details); //mapeia a operação para a unidade funcional capaz de executá-la
+    std::string verificaUFInstrucao(const InstrucaoDetalhes& instr_details) const; //mapeia a operação para a unidade funcional capaz de executá-la
 
     UnidadeFuncional* getFUVaziaArithInt(const std::string& tipoFU); // retorna ponteiro para a unidade funcional livre
 
     UnidadeFuncionalMemoria* getFUVaziaMem(const std::string& tipoFU);
 
-    int getCiclos(const InstrucaoDetalhes& instr_details); //retorna o número de ciclos que a instrução gasta
+    int getCiclos(const InstrucaoDetalhes& instr_details) const; //retorna o número de ciclos que a instrução gasta
 
     void alocaFU(UnidadeFuncional& uf, const InstrucaoDetalhes& instr_details, EstadoInstrucao& estado_instr_orig); // aloca uma unidade funcional para a instrução
 
     void alocaFuMem(UnidadeFuncionalMemoria& uf_mem, const InstrucaoDetalhes& instr_details, EstadoInstrucao& estado_instr_orig); // aloca uma unidade funcional para a instrução
 
-    void escreveEstacaoRegistrador(const InstrucaoDetalhes& instr_details, const std::string& ufNome); // informa ao registrador final qual unidade funcional irá lhe entregar o resultado da operação
+    static bool ehOperacaoVetorial(const std::string& operacao); // ADDV, SUBV, MULV, LV e SV
+
+    bool temUnidadesVetoriais() const; // alguma unidade VAdd/VMult/VLoad/VStore configurada
+
+    static std::vector<std::string> registradoresFonte(const InstrucaoDetalhes& instr_details); // operandos lidos pela instrução: {Qj, Qk} em alocaFU, {Qi, Qj} em alocaFuMem ("" = sem operando)
+
+    static std::optional<std::string> registradorDestino(const InstrucaoDetalhes& instr_details); // registrador escrito pela instrução (nenhum para SD e desvios)
+
+    void escreveEstacaoRegistrador(const EstadoInstrucao& estado_instr, const std::string& ufNome); // informa ao registrador final qual unidade funcional irá lhe entregar o resultado da operação
 
     void liberaUFEsperandoResultado(const std::string& nomeUFQueTerminou); // libera dependeências que estavam esperando a liberação da unidade funcional(CDB)
 
@@ -42,14 +58,36 @@ public:
 
     bool verificaSeJaTerminou(); // retorna true se todas as instruções do arquivo de entrada tiverem escrito seus resultados
 
-    void issueNovaInstrucao(); // busca a nova instrução, procura uma unidade funcional para alocá-la e marca o ciclo de emissão da instrução
+    virtual void issueNovaInstrucao(); // busca a nova instrução, procura uma unidade funcional para alocá-la e marca o ciclo de emissão da instrução
+
+    bool emiteInstrucao(EstadoInstrucao& nova_instr_estado); // aloca uma unidade funcional livre para a instrução e marca o ciclo de emissão; false se não houver unidade livre
 
     void executaInstrucao(); // verifica se a unidade funcional não tem dependências, decrementa o tempo restante de execução e marca o ciclo de término da instrução
 
+    void encadeiaOperacoesVetoriais(); // encadeamento: libera operandos vetoriais cujo produtor já entregou o primeiro elemento
+
+    static int comprimentoSETVL(const InstrucaoDetalhes& instr_details, int comprimento_maximo); // comprimento pedido por um SETVL, limitado a [1, VLEN]
+
+    void defineComprimentoVetor(const EstadoInstrucao& estado_instr); // SETVL: atualiza o registrador de comprimento vetorial da thread
+
     void escreveInstrucao(); // registra o resultado da instrução em seu registrador de destino
 
+    bool prontaParaEscrever(const EstadoInstrucao* estado_instr, const std::optional<int>& tempo) const; // execução terminou em um ciclo anterior e o resultado ainda não foi escrito
+
+    void escreveResultado(UnidadeFuncional& uf); // escrita no CDB: marca o ciclo, atualiza o registrador, acorda dependentes e libera a unidade
+
+    void escreveResultadoMem(UnidadeFuncionalMemoria& uf_mem);
+
     bool executa_ciclo(); // exxecuta um ciclo completo
 
+    bool executaAteTerminar(int limite_ciclos); // executa ciclos até todas as instruções escreverem ou o limite ser atingido
+
+    int limiteCiclosSeguro() const; // limite superior de ciclos para o traço atual (execução totalmente serializada)
+
+    virtual TabelaRegistradores& tabelaRegistradores(const EstadoInstrucao& estado_instr); // tabela de status de registradores vista pela instrução (uma por thread no SMT)
+
+    virtual void aoEscreverInstrucao(EstadoInstrucao& estado_instr); // chamado logo após a instrução receber seu ciclo de escrita
+
     void printEstadoDebug() const; // imprime o estado das instruções, unidades funcionais, memória e registradores
 };
 
@@ -0,0 +1,55 @@
+#ifndef ESTADO_SMT_HPP
+#define ESTADO_SMT_HPP
+
+#include "estado.hpp"
+#include <map>
+#include <string>
+#include <vector>
+
+enum class PoliticaEmissao {
+    RoundRobin, // alterna entre as threads a cada emissão
+    ICount      // prioriza a thread com menos instruções em voo
+};
+
+struct ContextoThread { // estado privado de cada fluxo de instruções
+    TabelaRegistradores estacaoRegistradores;
+    size_t inicio = 0;          // faixa da thread em estadoInstrucoes
+    size_t fim = 0;
+    size_t proximaEmissao = 0;  // cursor de emissão da thread
+    int emVoo = 0;              // emitidas e ainda não escritas (usado pelo ICOUNT)
+    int escritas = 0;
+    int ultimaEscrita = 0;      // ciclo em que a thread terminou
+    long long bloqueiosEstruturais = 0; // ciclos em que a próxima instrução não achou unidade livre
+    long long ciclosSemVez = 0;         // ciclos em que podia emitir, mas outra thread levou o slot
+};
+
+class EstadoSMT : public Estado { // vários traços compartilhando as mesmas unidades funcionais
+public:
+    std::vector<ContextoThread> threads;
+    PoliticaEmissao politica;
+    size_t proximaThread = 0;                            // ponto de partida do round-robin
+    std::map<std::string, long long> bloqueiosPorTipo;    // emissões barradas por falta de unidade, por tipo
+    std::map<std::string, long long> ocupacaoPorTipo;     // soma, a cada ciclo, das unidades ocupadas por tipo
+
+    EstadoSMT(const ConfigSimulador& cfg, const std::vector<std::vector<InstrucaoInput>>& tracos, PoliticaEmissao politica_emissao);
+
+    void issueNovaInstrucao() override; // escolhe a thread pela política e emite no máximo uma instrução por ciclo
+
+    TabelaRegistradores& tabelaRegistradores(const EstadoInstrucao& estado_instr) override;
+
+    void aoEscreverInstrucao(EstadoInstrucao& estado_instr) override;
+
+    void imprimeRelatorioSMT() const; // IPC por thread e agregado, e disputa pelas unidades funcionais
+
+private:
+    std::vector<size_t> ordemDeTentativa() const; // ordem em que as threads tentam emitir neste ciclo
+    void amostraOcupacao();
+};
+
+bool parsePoliticaEmissao(const std::string& nome, PoliticaEmissao& politica); // "rr" ou "icount"
+
+bool mesmaMaquina(const ConfigSimulador& a, const ConfigSimulador& b); // mesma configuração de hardware (ignora numInstrucoes)
+
+bool semConfigMaquina(const ConfigSimulador& config); // arquivo sem CYCLES/UNITS/MEM_UNITS/VLEN/CHAINING/CDB/CDB_PRIORITY: herda a máquina do primeiro traço
+
+#endif
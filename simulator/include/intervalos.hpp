@@ -0,0 +1,32 @@
+#ifndef INTERVALOS_HPP
+#define INTERVALOS_HPP
+
+#include "types.hpp"
+#include <vector>
+#include <optional>
+
+struct ResultadoIntervalo { // resultado da simulação de um intervalo do traço
+    int inicio = 0;          // primeira instrução medida do intervalo
+    int fim = 0;             // uma posição após a última instrução medida
+    int inicioAquecimento = 0; // primeira instrução simulada (inclui o aquecimento)
+    int ciclos = 0;          // ciclos atribuídos ao intervalo (descontado o aquecimento)
+    bool terminou = false;
+};
+
+struct ResultadoIntervalos {
+    std::vector<ResultadoIntervalo> intervalos;
+    long long ciclosEstimados = 0;           // soma dos ciclos de cada intervalo
+    std::optional<int> ciclosReferencia;      // execução sequencial completa do Estado (opcional)
+    double segundosParalelo = 0.0;
+    double segundosReferencia = 0.0;
+    int threadsUsadas = 0;
+};
+
+// divide o traço em num_intervalos partes, simula cada uma em sua própria thread com
+// aquecimento de até 'aquecimento' instruções do intervalo anterior e soma os ciclos
+ResultadoIntervalos simulaIntervalos(const ConfigSimulador& config, const std::vector<InstrucaoInput>& instrucoes,
+                                     int num_intervalos, int aquecimento, bool com_referencia);
+
+void imprimeResultadoIntervalos(const ResultadoIntervalos& resultado); // relatório por intervalo, total estimado e erro
+
+#endif
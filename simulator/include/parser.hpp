@@ -2,9 +2,14 @@
 #define PARSER_HPP
 
 #include "types.hpp"
+#include <istream>
 #include <string>
 #include <vector>
 
 bool parseInputFile(const std::string& filename, ConfigSimulador& out_config, std::vector<InstrucaoInput>& out_instructions);
 
+bool parseInput(std::istream& input, ConfigSimulador& out_config, std::vector<InstrucaoInput>& out_instructions);
+
+bool writeInputFile(const std::string& filename, const ConfigSimulador& config, const std::vector<InstrucaoInput>& instructions);
+
 #endif
\ No newline at end of file
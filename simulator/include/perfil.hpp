@@ -0,0 +1,86 @@
+#ifndef PERFIL_HPP
+#define PERFIL_HPP
+
+// Instrumentação dos estágios do simulador, desligada por padrão.
+// Compile com -DTOMASULO_PERFIL (make PERFIL=1) para medir o tempo de issue, execução e escrita em
+// cada ciclo e de cada chamada de liberação de dependências. Em x86 o relógio é o contador de ciclos
+// (rdtsc), bem mais barato que steady_clock; nas demais arquiteturas, steady_clock. Os estágios de
+// executa_ciclo compartilham as leituras do relógio: uma no início do ciclo e uma ao fim de cada
+// estágio. Os tempos são somados por ciclo simulado, convertidos para ns na saída e o relatório com
+// percentis é impresso em std::cerr ao fim do programa. Sem a flag, as macros abaixo não geram código algum.
+
+#ifdef TOMASULO_PERFIL
+
+#include <chrono>
+#include <cstdint>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+enum class EstagioPerfil { Issue = 0, Execucao, Escrita, Liberacao, Ciclo, Total };
+
+inline std::uint64_t leRelogioPerfil() { // em ticks; perfil.cpp calibra a conversão para ns contra steady_clock
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+void registraTempoEstagio(EstagioPerfil estagio, std::uint64_t ticks); // acumula no ciclo corrente da thread
+
+// encerra o ciclo corrente: os tempos dos estágios de executa_ciclo (indexados por EstagioPerfil) e os
+// acumulados por registraTempoEstagio viram uma amostra por estágio; uma única chamada por ciclo
+void fechaCicloPerfil(const std::uint64_t (&tempos_ciclo)[static_cast<int>(EstagioPerfil::Total)]);
+
+class MedidorEstagio { // mede o escopo em que foi declarado
+public:
+    explicit MedidorEstagio(EstagioPerfil estagio_medido)
+        : estagio(estagio_medido), inicio(leRelogioPerfil()) {}
+    ~MedidorEstagio() { registraTempoEstagio(estagio, leRelogioPerfil() - inicio); }
+    MedidorEstagio(const MedidorEstagio&) = delete;
+    MedidorEstagio& operator=(const MedidorEstagio&) = delete;
+
+private:
+    EstagioPerfil estagio;
+    std::uint64_t inicio;
+};
+
+class MarcadorCiclo { // estágios consecutivos de um ciclo: cada marca fecha um estágio e abre o seguinte
+public:
+    MarcadorCiclo() : inicio(leRelogioPerfil()), ultimaMarca(inicio) {}
+    void marca(EstagioPerfil estagio) { // só guarda o tempo: o registro é feito uma vez, em fecha()
+        std::uint64_t agora = leRelogioPerfil();
+        tempos[static_cast<int>(estagio)] += agora - ultimaMarca;
+        ultimaMarca = agora;
+    }
+    void fecha() { // o ciclo inteiro vai do início até a última marca, sem outra leitura do relógio
+        tempos[static_cast<int>(EstagioPerfil::Ciclo)] = ultimaMarca - inicio;
+        fechaCicloPerfil(tempos);
+    }
+    MarcadorCiclo(const MarcadorCiclo&) = delete;
+    MarcadorCiclo& operator=(const MarcadorCiclo&) = delete;
+
+private:
+    std::uint64_t inicio;
+    std::uint64_t ultimaMarca;
+    std::uint64_t tempos[static_cast<int>(EstagioPerfil::Total)] = {};
+};
+
+#define PERFIL_CONCATENA_(a, b) a##b
+#define PERFIL_CONCATENA(a, b) PERFIL_CONCATENA_(a, b)
+#define PERFIL_ESTAGIO(estagio) MedidorEstagio PERFIL_CONCATENA(medidor_perfil_, __LINE__)(EstagioPerfil::estagio)
+#define PERFIL_INICIA_CICLO() MarcadorCiclo marcador_ciclo_perfil
+#define PERFIL_MARCA(estagio) marcador_ciclo_perfil.marca(EstagioPerfil::estagio)
+#define PERFIL_FECHA_CICLO() marcador_ciclo_perfil.fecha()
+
+#else
+
+#define PERFIL_ESTAGIO(estagio) ((void)0)
+#define PERFIL_INICIA_CICLO() ((void)0)
+#define PERFIL_MARCA(estagio) ((void)0)
+#define PERFIL_FECHA_CICLO() ((void)0)
+
+#endif
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef REGIME_HPP
+#define REGIME_HPP
+
+#include "estado.hpp"
+
+// Detecção de regime permanente em traços de laço.
+// A cada fronteira de iteração (instrução seguinte a um desvio do corpo repetido) o estado da máquina
+// é normalizado em relação à iteração: ocupação das estações, tempos restantes, tags dos registradores
+// e posições das instruções em voo relativas ao início da iteração. Quando um estado se repete, o
+// escalonamento passa a ser periódico e os ciclos das iterações restantes são extrapolados.
+
+struct ResultadoRegime {
+    bool lacoDetectado = false;
+    bool extrapolou = false;
+    int instrucoesPorIteracao = 0;
+    int iteracaoInicial = 0;       // iteração cujo estado se repetiu
+    int iteracaoRepetida = 0;      // iteração em que o estado se repetiu
+    int ciclosPorPeriodo = 0;      // ciclos entre as duas fronteiras
+    int instrucoesPorPeriodo = 0;  // instruções entre as duas fronteiras
+    int ciclosSimulados = 0;       // ciclos realmente simulados
+    int instrucoesExtrapoladas = 0;
+};
+
+ResultadoRegime executaComExtrapolacao(Estado& estado, int limite_ciclos); // simula até o regime e extrapola o restante
+
+void imprimeResultadoRegime(const ResultadoRegime& resultado, const Estado& estado);
+
+#endif
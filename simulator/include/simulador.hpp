@@ -0,0 +1,140 @@
+#ifndef SIMULADOR_HPP
+#define SIMULADOR_HPP
+
+#include "estado.hpp"
+#include "parser.hpp"
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// API C++ estável para embutir o simulador em outras ferramentas, sem depender da saída em std::cout.
+// Os eventos de estágio são entregues a uma política de observação escolhida em tempo de compilação:
+// com o ObservadorNulo (padrão) todo o código de notificação é removido pelo compilador.
+
+struct ObservadorNulo { // não observa nada; o Simulador não faz nenhum trabalho extra
+    static constexpr bool ativo = false;
+    void aoEmitir(const EstadoInstrucao&, int) {}
+    void aoCompletarExecucao(const EstadoInstrucao&, int) {}
+    void aoEscrever(const EstadoInstrucao&, int) {}
+};
+
+struct ObservadorBase { // base para observadores reais: sobrescreva apenas os eventos de interesse
+    static constexpr bool ativo = true;
+    void aoEmitir(const EstadoInstrucao&, int) {}            // issue da instrução no ciclo
+    void aoCompletarExecucao(const EstadoInstrucao&, int) {} // exeCompleta da instrução no ciclo
+    void aoEscrever(const EstadoInstrucao&, int) {}          // write da instrução no ciclo
+};
+
+struct TemposInstrucao { // ciclos de cada estágio de uma instrução (vazio se ainda não aconteceu)
+    std::optional<int> issue;
+    std::optional<int> exeCompleta;
+    std::optional<int> write;
+};
+
+struct EstatisticasSimulacao {
+    int ciclos = 0;
+    int instrucoes = 0;
+    int emitidas = 0;
+    int completas = 0;
+    double ipc = 0.0; // instruções completas por ciclo
+    int conflitosCDB = 0; // escritas adiadas por falta de barramento (CDB)
+};
+
+template <typename Observador = ObservadorNulo>
+class Simulador {
+public:
+    Simulador(const ConfigSimulador& cfg, const std::vector<InstrucaoInput>& instrucoes, Observador obs = Observador())
+        : estado(cfg, instrucoes), observador(std::move(obs)) {}
+
+    // o Estado guarda ponteiros para suas próprias instruções, então o Simulador não é copiável nem movível
+    Simulador(const Simulador&) = delete;
+    Simulador& operator=(const Simulador&) = delete;
+
+    static std::unique_ptr<Simulador> deArquivo(const std::string& arquivo, Observador obs = Observador()) { // nullptr se o arquivo não puder ser lido
+        ConfigSimulador cfg;
+        std::vector<InstrucaoInput> instrucoes;
+        if (!parseInputFile(arquivo, cfg, instrucoes)) return nullptr;
+        return std::make_unique<Simulador>(cfg, instrucoes, std::move(obs));
+    }
+
+    static std::unique_ptr<Simulador> deTexto(const std::string& conteudo, Observador obs = Observador()) { // mesmo formato do arquivo de entrada
+        ConfigSimulador cfg;
+        std::vector<InstrucaoInput> instrucoes;
+        std::istringstream entrada(conteudo);
+        if (!parseInput(entrada, cfg, instrucoes)) return nullptr;
+        return std::make_unique<Simulador>(cfg, instrucoes, std::move(obs));
+    }
+
+    int step(int n = 1) { // executa até n ciclos num único laço; retorna quantos ciclos foram executados
+        int executados = 0;
+        bool fim = estado.verificaSeJaTerminou();
+        while (executados < n && !fim) {
+            fim = estado.executa_ciclo();
+            executados++;
+            if constexpr (Observador::ativo) {
+                notificaEventos();
+            }
+        }
+        return executados;
+    }
+
+    bool executaAteTerminar() { // roda até o fim (ou até o limite seguro de ciclos); true se terminou
+        step(estado.limiteCiclosSeguro() - estado.clock_cycle);
+        return terminou();
+    }
+
+    bool terminou() const { return estado.instrucoesEscritas >= estado.estadoInstrucoes.size(); }
+
+    int ciclo() const { return estado.clock_cycle; }
+
+    int numInstrucoes() const { return static_cast<int>(estado.estadoInstrucoes.size()); }
+
+    TemposInstrucao tempos(int indice) const {
+        const EstadoInstrucao& instr = estado.estadoInstrucoes.at(indice);
+        return TemposInstrucao{instr.issue, instr.exeCompleta, instr.write};
+    }
+
+    EstatisticasSimulacao estatisticas() const {
+        EstatisticasSimulacao stats;
+        stats.ciclos = estado.clock_cycle;
+        stats.instrucoes = numInstrucoes();
+        stats.emitidas = static_cast<int>(estado.proximaEmissao);
+        if (estado.proximaEmissao < estado.estadoInstrucoes.size() && estado.estadoInstrucoes[estado.proximaEmissao].issue.has_value()) {
+            stats.emitidas++; // o cursor só avança na próxima tentativa de emissão
+        }
+        stats.completas = static_cast<int>(estado.instrucoesEscritas);
+        stats.ipc = stats.ciclos > 0 ? static_cast<double>(stats.completas) / stats.ciclos : 0.0;
+        stats.conflitosCDB = estado.conflitosCDB;
+        return stats;
+    }
+
+    const Estado& motor() const { return estado; } // acesso somente leitura ao estado completo
+
+    Observador& getObservador() { return observador; }
+
+private:
+    Estado estado;
+    Observador observador;
+    size_t primeiraPendente = 0; // primeira instrução ainda não escrita (início da janela observada)
+
+    void notificaEventos() { // varre apenas a janela de instruções em voo atrás dos eventos deste ciclo
+        const int ciclo_atual = estado.clock_cycle;
+        auto& instrucoes = estado.estadoInstrucoes;
+        while (primeiraPendente < instrucoes.size() && instrucoes[primeiraPendente].write.has_value() &&
+               instrucoes[primeiraPendente].write.value() < ciclo_atual) {
+            primeiraPendente++;
+        }
+        const size_t fim_janela = std::min(instrucoes.size(), estado.proximaEmissao + 1);
+        for (size_t i = primeiraPendente; i < fim_janela; ++i) {
+            const EstadoInstrucao& instr = instrucoes[i];
+            if (instr.issue == ciclo_atual) observador.aoEmitir(instr, ciclo_atual);
+            if (instr.exeCompleta == ciclo_atual) observador.aoCompletarExecucao(instr, ciclo_atual);
+            if (instr.write == ciclo_atual) observador.aoEscrever(instr, ciclo_atual);
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef TOMASULO_H
+#define TOMASULO_H
+
+/* ABI C do simulador: funções com nomes estáveis, sem tipos C++ na interface. */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct tomasulo_simulador tomasulo_simulador;
+
+typedef struct {
+    int issue;        /* -1 enquanto o estágio não aconteceu */
+    int exe_completa;
+    int write;
+} tomasulo_tempos;
+
+typedef struct {
+    int ciclos;
+    int instrucoes;
+    int emitidas;
+    int completas;
+    double ipc;
+} tomasulo_estatisticas;
+
+tomasulo_simulador* tomasulo_cria(const char* arquivo);          /* NULL se o arquivo não puder ser lido */
+tomasulo_simulador* tomasulo_cria_de_texto(const char* conteudo); /* mesmo formato do arquivo de entrada */
+void tomasulo_destroi(tomasulo_simulador* sim);
+
+int tomasulo_step(tomasulo_simulador* sim, int n);  /* executa até n ciclos; retorna quantos foram executados */
+int tomasulo_executa(tomasulo_simulador* sim);      /* roda até o fim; 1 se terminou, 0 se atingiu o limite */
+int tomasulo_terminou(const tomasulo_simulador* sim);
+int tomasulo_ciclo(const tomasulo_simulador* sim);
+int tomasulo_num_instrucoes(const tomasulo_simulador* sim);
+
+int tomasulo_tempos_instrucao(const tomasulo_simulador* sim, int indice, tomasulo_tempos* saida); /* 0 se ok, -1 se índice inválido */
+void tomasulo_obtem_estatisticas(const tomasulo_simulador* sim, tomasulo_estatisticas* saida);
+int tomasulo_conflitos_cdb(const tomasulo_simulador* sim); /* escritas adiadas por falta de barramento (CDB) */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
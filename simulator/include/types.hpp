@@ -4,6 +4,7 @@
 #include <string>
 #include <optional>
 #include <map>
+#include <vector>
 
 struct InstrucaoInput { // armazena a instrução lida no arquivo de entrada
     std::string d_operacao;
@@ -17,6 +18,12 @@ struct ConfigSimulador {
     std::map<std::string, int> ciclos;
     std::map<std::string, int> unidades;
     std::map<std::string, int> unidadesMem;
+    int comprimentoVetorMaximo = 64; // VLEN: valor inicial e teto do registrador de comprimento vetorial
+    bool encadeamento = false;       // CHAINING: operação vetorial dependente começa no primeiro elemento produzido
+    std::map<std::string, int> custos; // COST: peso de hardware de cada unidade de um tipo (padrão 1, usado pelo ajuste)
+    int orcamento = 0;                 // BUDGET: custo total permitido no ajuste (0 = o dobro do custo configurado)
+    int barramentosCDB = 0;                  // CDB: escritas por ciclo (0 = ilimitado)
+    std::vector<std::string> prioridadeCDB;  // CDB_PRIORITY: tipos de unidade em ordem de prioridade (vazio = mais antiga primeiro)
 };
 
 struct InstrucaoDetalhes { // campos da instrução
@@ -33,6 +40,7 @@ struct EstadoInstrucao { // guarda o estado de uma determinada instrução duran
     std::optional<int> exeCompleta;
     std::optional<int> write;
     bool busy = false;
+    int thread = 0; // fluxo de instruções de origem (modo SMT)
 
     EstadoInstrucao() : posicao(0), busy(false) {}
     EstadoInstrucao(InstrucaoDetalhes details, int pos)
@@ -51,6 +59,7 @@ struct UnidadeFuncional {
     std::optional<std::string> vk;
     std::optional<std::string> qj;
     std::optional<std::string> qk;
+    std::optional<int> comprimentoVetor; // elementos da operação vetorial em andamento (VLR no issue)
 };
 
 struct UnidadeFuncionalMemoria {
@@ -5,4 +5,6 @@
 
 std::string trim(const std::string& str);
 
+bool parseInteiro(const std::string& texto, long long minimo, long long maximo, long long& saida); // inteiro decimal completo dentro de [minimo, maximo]
+
 #endif
\ No newline at end of file
@@ -0,0 +1,304 @@
+#include "ajuste.hpp"
+#include "estado.hpp"
+#include "regime.hpp"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <random>
+#include <set>
+#include <thread>
+
+namespace {
+
+const int MAXIMO_POR_TIPO = 32; // além disso a emissão (uma instrução por ciclo) domina em qualquer traço realista
+
+bool ehTipoMemoria(const std::string& tipo) {
+    return tipo == "Load" || tipo == "Store";
+}
+
+struct EspacoBusca {
+    const ResultadoAjuste& ajuste;
+    std::vector<int> maximo; // teto de unidades de cada tipo
+
+    int custo(const std::vector<int>& unidades) const {
+        int total = 0;
+        for (size_t t = 0; t < unidades.size(); ++t) total += unidades[t] * ajuste.custos[t];
+        return total;
+    }
+
+    void repara(std::vector<int>& unidades, std::mt19937& gerador) const { // volta para dentro dos limites e do orçamento
+        for (size_t t = 0; t < unidades.size(); ++t) {
+            unidades[t] = std::clamp(unidades[t], 1, maximo[t]);
+        }
+        while (custo(unidades) > ajuste.orcamento) {
+            std::vector<size_t> redutiveis;
+            for (size_t t = 0; t < unidades.size(); ++t) {
+                if (unidades[t] > 1) redutiveis.push_back(t);
+            }
+            unidades[redutiveis[gerador() % redutiveis.size()]]--;
+        }
+    }
+
+    std::vector<int> aleatoria(std::mt19937& gerador) const {
+        std::vector<int> unidades(maximo.size());
+        for (size_t t = 0; t < unidades.size(); ++t) {
+            unidades[t] = 1 + static_cast<int>(gerador() % maximo[t]);
+        }
+        repara(unidades, gerador);
+        return unidades;
+    }
+
+    std::vector<int> vizinha(std::vector<int> unidades, std::mt19937& gerador) const { // passo de subida de encosta
+        size_t t = gerador() % unidades.size();
+        if (unidades.size() > 1 && gerador() % 2 == 0) {
+            size_t outro = (t + 1 + gerador() % (unidades.size() - 1)) % unidades.size(); // troca uma unidade entre dois tipos
+            unidades[t]++;
+            unidades[outro]--;
+        } else {
+            unidades[t] += gerador() % 2 == 0 ? 1 : -1;
+        }
+        repara(unidades, gerador);
+        return unidades;
+    }
+};
+
+bool domina(const ConfiguracaoAvaliada& a, const ConfiguracaoAvaliada& b) { // a não é pior em nada e é melhor em algo
+    if (!a.terminou) return false;
+    if (!b.terminou) return true;
+    return a.ciclos <= b.ciclos && a.custo <= b.custo && (a.ciclos < b.ciclos || a.custo < b.custo);
+}
+
+std::vector<int> nivelDominancia(const std::vector<ConfiguracaoAvaliada>& candidatos) { // 0 = não dominado, 1 = só dominado pelo nível 0, ...
+    const size_t n = candidatos.size();
+    std::vector<int> nivel(n, -1);
+    size_t atribuidos = 0;
+    for (int atual = 0; atribuidos < n; ++atual) {
+        std::vector<size_t> deste_nivel;
+        for (size_t i = 0; i < n; ++i) {
+            if (nivel[i] >= 0) continue;
+            bool dominado = false;
+            for (size_t j = 0; j < n && !dominado; ++j) {
+                dominado = j != i && (nivel[j] < 0 || nivel[j] == atual) && domina(candidatos[j], candidatos[i]);
+            }
+            if (!dominado) deste_nivel.push_back(i);
+        }
+        for (size_t i : deste_nivel) nivel[i] = atual;
+        atribuidos += deste_nivel.size();
+    }
+    return nivel;
+}
+
+ConfigSimulador aplicaUnidades(const ConfigSimulador& config, const ResultadoAjuste& ajuste, const std::vector<int>& unidades) { // configuração com as quantidades de um candidato
+    ConfigSimulador candidata = config;
+    for (size_t t = 0; t < ajuste.tipos.size(); ++t) {
+        auto& destino = ehTipoMemoria(ajuste.tipos[t]) ? candidata.unidadesMem : candidata.unidades;
+        destino[ajuste.tipos[t]] = unidades[t];
+    }
+    return candidata;
+}
+
+}
+
+ResultadoAjuste ajustaUnidades(const ConfigSimulador& config, const std::vector<InstrucaoInput>& instrucoes,
+                               const ParametrosAjuste& parametros) {
+    ResultadoAjuste resultado;
+    if (instrucoes.empty()) return resultado;
+    auto inicio = std::chrono::steady_clock::now();
+
+    // só os tipos que o traço usa entram na busca; o teto de cada um é o número de instruções daquele tipo
+    std::map<std::string, int> instrucoes_por_tipo;
+    {
+        Estado decodificado(config, instrucoes);
+        for (const auto& instr : decodificado.estadoInstrucoes) {
+            instrucoes_por_tipo[decodificado.verificaUFInstrucao(instr.instrucao)]++;
+        }
+    }
+    std::vector<int> original;
+    EspacoBusca espaco{resultado, {}};
+    for (const auto& pair : instrucoes_por_tipo) {
+        if (pair.first.empty()) continue;
+        resultado.tipos.push_back(pair.first);
+        auto custo = config.custos.find(pair.first);
+        resultado.custos.push_back(custo != config.custos.end() ? std::max(1, custo->second) : 1);
+        espaco.maximo.push_back(std::min(pair.second, MAXIMO_POR_TIPO));
+        const auto& unidades = ehTipoMemoria(pair.first) ? config.unidadesMem : config.unidades;
+        auto configurado = unidades.find(pair.first);
+        original.push_back(configurado != unidades.end() ? std::max(1, configurado->second) : 1);
+    }
+
+    resultado.orcamento = config.orcamento > 0 ? config.orcamento : 2 * espaco.custo(original);
+    if (espaco.custo(std::vector<int>(resultado.tipos.size(), 1)) > resultado.orcamento) {
+        std::cerr << "Error: BUDGET " << resultado.orcamento << " cannot fit one unit of each type used by the trace" << std::endl;
+        return resultado;
+    }
+
+    std::map<std::vector<int>, ConfiguracaoAvaliada> cache;
+    resultado.threadsUsadas = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+
+    auto avalia = [&](const std::vector<std::vector<int>>& candidatos) { // simula em paralelo os candidatos ainda fora do cache
+        std::vector<std::vector<int>> novos;
+        std::set<std::vector<int>> pedidos;
+        for (const auto& unidades : candidatos) {
+            if (cache.count(unidades) || !pedidos.insert(unidades).second) {
+                resultado.acertosCache++;
+            } else {
+                novos.push_back(unidades);
+            }
+        }
+
+        std::vector<ConfiguracaoAvaliada> avaliados(novos.size());
+        std::atomic<int> proximo{0};
+        std::vector<std::thread> threads;
+        const int total = static_cast<int>(novos.size());
+        for (int t = 0; t < std::min(resultado.threadsUsadas, total); ++t) {
+            threads.emplace_back([&]() {
+                for (int k = proximo++; k < total; k = proximo++) {
+                    Estado estado(aplicaUnidades(config, resultado, novos[k]), instrucoes);
+                    executaComExtrapolacao(estado, estado.limiteCiclosSeguro());
+                    avaliados[k].unidades = novos[k];
+                    avaliados[k].custo = espaco.custo(novos[k]);
+                    avaliados[k].ciclos = estado.clock_cycle;
+                    avaliados[k].terminou = estado.verificaSeJaTerminou();
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        for (auto& avaliado : avaliados) {
+            cache.emplace(avaliado.unidades, std::move(avaliado));
+        }
+        resultado.avaliacoes += total;
+    };
+
+    std::mt19937 gerador(parametros.semente);
+    const int tamanho = std::max(2, parametros.populacao);
+
+    // população inicial: a configuração do arquivo (ajustada ao orçamento), a mínima e sorteios
+    std::vector<std::vector<int>> populacao;
+    std::vector<int> inicial = original;
+    espaco.repara(inicial, gerador);
+    populacao.push_back(inicial);
+    populacao.push_back(std::vector<int>(resultado.tipos.size(), 1));
+    while (static_cast<int>(populacao.size()) < tamanho) {
+        populacao.push_back(espaco.aleatoria(gerador));
+    }
+    avalia(populacao);
+    if (espaco.custo(original) <= resultado.orcamento) {
+        auto it = cache.find(original);
+        if (it == cache.end()) {
+            avalia({original});
+            it = cache.find(original);
+        }
+        resultado.configuracaoOriginal = it->second;
+    }
+
+    auto melhor = [&](const std::vector<int>& nivel, size_t a, size_t b) { // torneio: nível de Pareto, depois ciclos, depois custo
+        const ConfiguracaoAvaliada& ca = cache.at(populacao[a]);
+        const ConfiguracaoAvaliada& cb = cache.at(populacao[b]);
+        if (nivel[a] != nivel[b]) return nivel[a] < nivel[b];
+        if (ca.terminou != cb.terminou) return ca.terminou;
+        if (ca.ciclos != cb.ciclos) return ca.ciclos < cb.ciclos;
+        return ca.custo < cb.custo;
+    };
+
+    for (int geracao = 0; geracao < parametros.geracoes; ++geracao) {
+        std::vector<ConfiguracaoAvaliada> avaliada_pop;
+        for (const auto& unidades : populacao) avaliada_pop.push_back(cache.at(unidades));
+        std::vector<int> nivel = nivelDominancia(avaliada_pop);
+
+        auto torneio = [&]() {
+            size_t a = gerador() % populacao.size(), b = gerador() % populacao.size();
+            return melhor(nivel, a, b) ? a : b;
+        };
+
+        std::vector<std::vector<int>> filhos;
+        for (int f = 0; f < tamanho; ++f) {
+            const std::vector<int>& pai = populacao[torneio()];
+            const std::vector<int>& mae = populacao[torneio()];
+            std::vector<int> filho(pai.size());
+            for (size_t t = 0; t < filho.size(); ++t) {
+                filho[t] = gerador() % 2 == 0 ? pai[t] : mae[t];
+            }
+            filhos.push_back(espaco.vizinha(filho, gerador));
+        }
+        avalia(filhos);
+
+        // sobrevivência: pais e filhos distintos, ordenados por nível de Pareto e ciclos
+        std::set<std::vector<int>> unicos(populacao.begin(), populacao.end());
+        unicos.insert(filhos.begin(), filhos.end());
+        populacao.assign(unicos.begin(), unicos.end());
+        avaliada_pop.clear();
+        for (const auto& unidades : populacao) avaliada_pop.push_back(cache.at(unidades));
+        nivel = nivelDominancia(avaliada_pop);
+        std::vector<size_t> ordem(populacao.size());
+        for (size_t i = 0; i < ordem.size(); ++i) ordem[i] = i;
+        std::sort(ordem.begin(), ordem.end(), [&](size_t a, size_t b) { return melhor(nivel, a, b); });
+        std::vector<std::vector<int>> sobreviventes;
+        for (size_t i = 0; i < ordem.size() && static_cast<int>(sobreviventes.size()) < tamanho; ++i) {
+            sobreviventes.push_back(populacao[ordem[i]]);
+        }
+        populacao = std::move(sobreviventes);
+    }
+
+    // fronteira sobre tudo o que foi simulado, não só a população final
+    for (const auto& pair : cache) {
+        const ConfiguracaoAvaliada& candidato = pair.second;
+        bool dominado = false;
+        for (const auto& outro : cache) {
+            if (domina(outro.second, candidato)) {
+                dominado = true;
+                break;
+            }
+        }
+        if (!dominado && candidato.terminou) resultado.fronteiraPareto.push_back(candidato);
+    }
+    std::sort(resultado.fronteiraPareto.begin(), resultado.fronteiraPareto.end(),
+              [](const ConfiguracaoAvaliada& a, const ConfiguracaoAvaliada& b) { return a.custo < b.custo; });
+
+    resultado.segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    return resultado;
+}
+
+void imprimeResultadoAjuste(const ResultadoAjuste& resultado) { // fronteira de Pareto com a alocação de cada ponto
+    auto descreve = [&](const std::vector<int>& unidades) {
+        std::string texto;
+        for (size_t t = 0; t < unidades.size(); ++t) {
+            texto += (t == 0 ? "" : " ") + resultado.tipos[t] + "=" + std::to_string(unidades[t]);
+        }
+        return texto;
+    };
+
+    std::cout << "\n[ AJUSTE DE UNIDADES ]" << std::endl;
+    std::cout << std::string(70, '-') << std::endl;
+    std::cout << "Orcamento: " << resultado.orcamento << "  |  Pesos:";
+    for (size_t t = 0; t < resultado.tipos.size(); ++t) {
+        std::cout << " " << resultado.tipos[t] << "=" << resultado.custos[t];
+    }
+    std::cout << std::endl;
+    if (resultado.configuracaoOriginal.has_value()) {
+        const ConfiguracaoAvaliada& original = resultado.configuracaoOriginal.value();
+        std::cout << "Configuracao do arquivo: " << original.ciclos << " ciclos, custo " << original.custo
+                  << " (" << descreve(original.unidades) << ")" << std::endl;
+    }
+    std::cout << std::string(70, '-') << std::endl;
+    std::cout << std::left
+              << std::setw(10) << "Custo"
+              << std::setw(10) << "Ciclos"
+              << "Unidades" << std::endl;
+    std::cout << std::string(70, '-') << std::endl;
+    for (const auto& ponto : resultado.fronteiraPareto) {
+        std::cout << std::left
+                  << std::setw(10) << ponto.custo
+                  << std::setw(10) << ponto.ciclos
+                  << descreve(ponto.unidades) << std::endl;
+    }
+    std::cout << std::string(70, '-') << std::endl;
+    std::cout << "Simulacoes: " << resultado.avaliacoes << "  |  Acertos no cache: " << resultado.acertosCache
+              << "  |  Threads: " << resultado.threadsUsadas
+              << "  |  Tempo: " << std::fixed << std::setprecision(3) << resultado.segundos << " s" << std::endl;
+    std::cout << std::defaultfloat << std::setprecision(6);
+}
@@ -0,0 +1,171 @@
+#include "analise.hpp"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <unordered_map>
+
+namespace {
+
+int latenciaEscrita(const Estado& estado, const InstrucaoDetalhes& instr_details, int produtores, int comprimento_vetor) { // ciclos entre operandos prontos e a escrita no CDB, como no Estado
+    int ciclos = estado.getCiclos(instr_details);
+    if (Estado::ehOperacaoVetorial(instr_details.operacao)) {
+        return ciclos + comprimento_vetor; // partida mais um elemento por ciclo, e a escrita
+    }
+    // alocaFU desconta um ciclo de ADDD/SUBD; as demais operações gastam o tempo configurado mais a escrita
+    if (instr_details.operacao == "ADDD" || instr_details.operacao == "SUBD") {
+        return std::max(1, ciclos);
+    }
+    // liberaUFEsperandoResultado desconta um ciclo por dependência resolvida nas unidades de memória,
+    // então um SD que espera dado e base pode ganhar um ciclo extra
+    if (instr_details.operacao == "SD" && produtores > 1) {
+        return std::max(1, ciclos);
+    }
+    return ciclos + 1;
+}
+
+}
+
+ResultadoAnalise analisaTraco(const Estado& estado) { // passagem O(N) sobre o traço decodificado
+    ResultadoAnalise analise;
+    const auto& instrucoes = estado.estadoInstrucoes;
+    const int n = static_cast<int>(instrucoes.size());
+    analise.numInstrucoes = n;
+    if (n == 0) return analise;
+
+    std::vector<long long> termino(n, 0);  // ciclo de escrita mais cedo possível de cada instrução
+    std::vector<long long> primeiroElemento(n, 0); // com encadeamento: quando o primeiro elemento vetorial fica pronto
+    std::vector<int> predecessor(n, -1);   // produtor que determinou o início (para reconstruir a cadeia)
+    std::unordered_map<std::string, int> ultimoProdutor;
+    int fim_critico = 0;
+    int latencia_ultima = 0;
+    const int comprimento_maximo = std::max(1, estado.config.comprimentoVetorMaximo);
+    int comprimento_vetor = comprimento_maximo;
+
+    for (int i = 0; i < n; ++i) {
+        const InstrucaoDetalhes& instr = instrucoes[i].instrucao;
+        const bool vetorial = Estado::ehOperacaoVetorial(instr.operacao);
+        long long pronto = 1; // o primeiro ciclo de emissão é o ciclo 1
+        int produtores = 0;
+        for (const std::string& fonte : Estado::registradoresFonte(instr)) {
+            auto it = ultimoProdutor.find(fonte);
+            if (it == ultimoProdutor.end()) continue;
+            produtores++;
+            const int p = it->second;
+            bool encadeia = vetorial && estado.config.encadeamento && primeiroElemento[p] > 0;
+            long long disponivel = encadeia ? primeiroElemento[p] : termino[p];
+            if (disponivel > pronto) {
+                pronto = disponivel;
+                predecessor[i] = p;
+            }
+        }
+
+        if (instr.operacao == "SETVL") {
+            comprimento_vetor = Estado::comprimentoSETVL(instr, comprimento_maximo);
+        }
+
+        int latencia = latenciaEscrita(estado, instr, produtores, comprimento_vetor);
+        termino[i] = pronto + latencia;
+        if (vetorial && instr.operacao != "SV") {
+            primeiroElemento[i] = pronto + estado.getCiclos(instr);
+        }
+        latencia_ultima = latencia;
+        if (termino[i] > termino[fim_critico]) fim_critico = i;
+
+        std::optional<std::string> destino = Estado::registradorDestino(instr);
+        if (destino.has_value()) ultimoProdutor[destino.value()] = i;
+
+        std::string tipo = estado.verificaUFInstrucao(instr);
+        LimiteRecurso& limite = analise.limitesRecurso[tipo];
+        limite.instrucoes++;
+        limite.ocupacao += latencia + 1; // a estação só volta a emitir no ciclo seguinte à escrita
+    }
+
+    analise.caminhoCritico = termino[fim_critico];
+    for (int i = fim_critico; i >= 0; i = predecessor[i]) {
+        analise.instrucoesCaminhoCritico.push_back(i);
+    }
+    std::reverse(analise.instrucoesCaminhoCritico.begin(), analise.instrucoesCaminhoCritico.end());
+    analise.ipcIdeal = static_cast<double>(n) / analise.caminhoCritico;
+    analise.limiteEmissao = n + latencia_ultima;
+
+    analise.limiteInferior = std::max(analise.caminhoCritico, analise.limiteEmissao);
+    // SD, SV, desvios e SETVL não difundem valor e terminam sem ocupar o CDB
+    const int produtores = static_cast<int>(std::count_if(instrucoes.begin(), instrucoes.end(), [](const EstadoInstrucao& instr) {
+        return Estado::registradorDestino(instr.instrucao).has_value();
+    }));
+    if (estado.config.barramentosCDB > 0 && produtores > 0) {
+        // a primeira escrita possível é no ciclo 2 (ADDD de um ciclo executa no próprio ciclo de issue),
+        // e cada ciclo escreve no máximo CDB resultados
+        analise.limiteCDB = 1 + (produtores + estado.config.barramentosCDB - 1) / estado.config.barramentosCDB;
+        if (analise.limiteCDB > analise.limiteInferior) {
+            analise.limiteInferior = analise.limiteCDB;
+            analise.recursoLimitante = "CDB";
+        }
+    }
+    for (auto& pair : analise.limitesRecurso) {
+        LimiteRecurso& limite = pair.second;
+        const auto& unidades = (pair.first == "Load" || pair.first == "Store") ? estado.config.unidadesMem : estado.config.unidades;
+        auto it = unidades.find(pair.first);
+        limite.unidades = it != unidades.end() ? it->second : 0;
+        if (limite.unidades <= 0) continue;
+        limite.ciclos = (limite.ocupacao + limite.unidades - 1) / limite.unidades;
+        if (limite.ciclos > analise.limiteInferior) {
+            analise.limiteInferior = limite.ciclos;
+            analise.recursoLimitante = pair.first;
+        }
+    }
+    return analise;
+}
+
+void imprimeAnalise(const ResultadoAnalise& analise, int ciclos_simulados) { // limites ao lado dos ciclos simulados
+    std::cout << "\n[ ANALISE DE FLUXO DE DADOS ]" << std::endl;
+    std::cout << std::string(70, '-') << std::endl;
+    std::cout << "Instrucoes: " << analise.numInstrucoes << std::endl;
+    std::cout << "Caminho critico (RAW, recursos ilimitados): " << analise.caminhoCritico << " ciclos, "
+              << analise.instrucoesCaminhoCritico.size() << " instrucoes" << std::endl;
+
+    std::cout << "  Cadeia:";
+    const size_t max_mostradas = 16;
+    for (size_t i = 0; i < analise.instrucoesCaminhoCritico.size() && i < max_mostradas; ++i) {
+        std::cout << (i == 0 ? " " : " -> ") << analise.instrucoesCaminhoCritico[i];
+    }
+    if (analise.instrucoesCaminhoCritico.size() > max_mostradas) std::cout << " -> ...";
+    std::cout << std::endl;
+
+    std::cout << "IPC ideal (limite do fluxo de dados): " << std::fixed << std::setprecision(3) << analise.ipcIdeal << std::endl;
+    std::cout << "Limite de emissao (1 instrucao/ciclo): " << analise.limiteEmissao << " ciclos" << std::endl;
+    if (analise.limiteCDB > 0) {
+        std::cout << "Limite de escrita (CDB): " << analise.limiteCDB << " ciclos" << std::endl;
+    }
+    std::cout << std::string(70, '-') << std::endl;
+
+    std::cout << std::left
+              << std::setw(12) << "Unidade"
+              << std::setw(14) << "Instrucoes"
+              << std::setw(10) << "Qtd"
+              << std::setw(14) << "Ocupacao"
+              << std::setw(14) << "Limite" << std::endl;
+    std::cout << std::string(70, '-') << std::endl;
+    for (const auto& pair : analise.limitesRecurso) {
+        const LimiteRecurso& limite = pair.second;
+        std::cout << std::left
+                  << std::setw(12) << pair.first
+                  << std::setw(14) << limite.instrucoes
+                  << std::setw(10) << limite.unidades
+                  << std::setw(14) << limite.ocupacao
+                  << std::setw(14) << (limite.unidades > 0 ? std::to_string(limite.ciclos) : "sem unidades") << std::endl;
+    }
+    std::cout << std::string(70, '-') << std::endl;
+
+    std::string limitante = analise.recursoLimitante.empty()
+                            ? (analise.caminhoCritico >= analise.limiteEmissao ? "caminho critico" : "emissao")
+                            : analise.recursoLimitante == "CDB" ? "barramento CDB" : "unidades " + analise.recursoLimitante;
+    std::cout << "Limite inferior: " << analise.limiteInferior << " ciclos (" << limitante << ")" << std::endl;
+    std::cout << "Ciclos simulados: " << ciclos_simulados;
+    if (analise.limiteInferior > 0) {
+        std::cout << "  |  Folga: " << std::setprecision(2)
+                  << static_cast<double>(ciclos_simulados) / analise.limiteInferior << "x do limite";
+    }
+    std::cout << std::endl;
+    std::cout << std::defaultfloat << std::setprecision(6);
+}
@@ -0,0 +1,304 @@
+#include "diferencial.hpp"
+#include "regime.hpp"
+#include <algorithm>
+#include <set>
+
+namespace {
+
+std::string registradorFloat(std::mt19937& rng) { // poucos registradores para forçar dependências
+    return "F" + std::to_string(2 * std::uniform_int_distribution<int>(0, 5)(rng));
+}
+
+std::string registradorInteiro(std::mt19937& rng) {
+    return "R" + std::to_string(std::uniform_int_distribution<int>(1, 4)(rng));
+}
+
+std::string registradorVetorial(std::mt19937& rng) {
+    return "V" + std::to_string(std::uniform_int_distribution<int>(1, 4)(rng));
+}
+
+InstrucaoInput geraInstrucaoAleatoria(std::mt19937& rng) {
+    static const char* const operacoes[] = {"ADDD", "SUBD", "MULTD", "DIVD", "LD", "SD", "ADD", "DADDUI", "BNEZ", "BEQ",
+                                            "ADDV", "SUBV", "MULV", "LV", "SV", "SETVL"};
+    InstrucaoInput instr;
+    instr.d_operacao = operacoes[std::uniform_int_distribution<int>(0, 15)(rng)];
+    const std::string& op = instr.d_operacao;
+
+    if (op == "LV" || op == "SV") {
+        instr.r_reg = registradorVetorial(rng);
+        instr.s_reg_or_imm = "0";
+        instr.t_reg_or_label = registradorInteiro(rng);
+    } else if (op == "ADDV" || op == "SUBV" || op == "MULV") {
+        instr.r_reg = registradorVetorial(rng);
+        instr.s_reg_or_imm = registradorVetorial(rng);
+        instr.t_reg_or_label = std::uniform_int_distribution<int>(0, 3)(rng) == 0 ? registradorFloat(rng) : registradorVetorial(rng);
+    } else if (op == "SETVL") {
+        instr.r_reg = std::to_string(std::uniform_int_distribution<int>(1, 8)(rng));
+    } else if (op == "LD" || op == "SD") {
+        instr.r_reg = registradorFloat(rng);
+        instr.s_reg_or_imm = std::to_string(8 * std::uniform_int_distribution<int>(0, 4)(rng));
+        instr.t_reg_or_label = registradorInteiro(rng);
+    } else if (op == "ADD") {
+        instr.r_reg = registradorInteiro(rng);
+        instr.s_reg_or_imm = registradorInteiro(rng);
+        instr.t_reg_or_label = registradorInteiro(rng);
+    } else if (op == "DADDUI") {
+        instr.r_reg = registradorInteiro(rng);
+        instr.s_reg_or_imm = registradorInteiro(rng);
+        instr.t_reg_or_label = std::to_string(std::uniform_int_distribution<int>(-8, 8)(rng));
+    } else if (op == "BNEZ") {
+        instr.r_reg = registradorInteiro(rng);
+        instr.s_reg_or_imm = "loop";
+    } else if (op == "BEQ") {
+        instr.r_reg = registradorInteiro(rng);
+        instr.s_reg_or_imm = registradorInteiro(rng);
+        instr.t_reg_or_label = "loop";
+    } else {
+        instr.r_reg = registradorFloat(rng);
+        instr.s_reg_or_imm = registradorFloat(rng);
+        instr.t_reg_or_label = registradorFloat(rng);
+    }
+    return instr;
+}
+
+bool reduzUmPasso(CasoTeste& caso, const PredicadoFalha& falha) { // tenta uma simplificação que preserve a falha
+    // remoção de blocos de instruções, do maior para o menor (delta debugging)
+    for (size_t bloco = std::max<size_t>(1, caso.instrucoes.size() / 2); bloco >= 1; bloco /= 2) {
+        for (size_t inicio = 0; inicio + bloco <= caso.instrucoes.size(); inicio += bloco) {
+            CasoTeste tentativa = caso;
+            tentativa.instrucoes.erase(tentativa.instrucoes.begin() + inicio, tentativa.instrucoes.begin() + inicio + bloco);
+            if (!tentativa.instrucoes.empty() && falha(tentativa)) {
+                caso = std::move(tentativa);
+                return true;
+            }
+        }
+        if (bloco == 1) break;
+    }
+
+    // sem as extensões opcionais: CDB ilimitado, sem prioridade, sem encadeamento e vetores de um elemento
+    const std::function<void(ConfigSimulador&)> simplificacoes[] = {
+        [](ConfigSimulador& c) { c.barramentosCDB = 0; c.prioridadeCDB.clear(); },
+        [](ConfigSimulador& c) { c.prioridadeCDB.clear(); },
+        [](ConfigSimulador& c) { if (!c.prioridadeCDB.empty()) c.prioridadeCDB.pop_back(); },
+        [](ConfigSimulador& c) { c.barramentosCDB = std::min(c.barramentosCDB, 1); },
+        [](ConfigSimulador& c) { c.encadeamento = false; },
+        [](ConfigSimulador& c) { c.comprimentoVetorMaximo = 1; },
+    };
+    for (const auto& simplifica : simplificacoes) {
+        CasoTeste tentativa = caso;
+        simplifica(tentativa.config);
+        if (tentativa.config.barramentosCDB == caso.config.barramentosCDB &&
+            tentativa.config.prioridadeCDB == caso.config.prioridadeCDB &&
+            tentativa.config.encadeamento == caso.config.encadeamento &&
+            tentativa.config.comprimentoVetorMaximo == caso.config.comprimentoVetorMaximo) {
+            continue; // nada a simplificar
+        }
+        if (falha(tentativa)) {
+            caso = std::move(tentativa);
+            return true;
+        }
+    }
+
+    // tipos de unidade que nenhuma instrução restante usa: primeiro todos de uma vez, depois um a um
+    std::set<std::string> tipos_usados;
+    const Estado estado(caso.config, caso.instrucoes);
+    for (const auto& instr : estado.estadoInstrucoes) {
+        tipos_usados.insert(estado.verificaUFInstrucao(instr.instrucao));
+    }
+    std::set<std::string> tipos_sem_uso;
+    for (auto membro : {&ConfigSimulador::unidades, &ConfigSimulador::unidadesMem, &ConfigSimulador::ciclos}) {
+        for (const auto& pair : caso.config.*membro) {
+            if (!tipos_usados.count(pair.first)) tipos_sem_uso.insert(pair.first);
+        }
+    }
+    auto sem_tipos = [&](const std::set<std::string>& tipos) {
+        CasoTeste tentativa = caso;
+        for (auto membro : {&ConfigSimulador::unidades, &ConfigSimulador::unidadesMem, &ConfigSimulador::ciclos}) {
+            for (const std::string& tipo : tipos) (tentativa.config.*membro).erase(tipo);
+        }
+        auto& prioridade = tentativa.config.prioridadeCDB;
+        prioridade.erase(std::remove_if(prioridade.begin(), prioridade.end(),
+                                        [&](const std::string& tipo) { return tipos.count(tipo) > 0; }),
+                         prioridade.end());
+        return tentativa;
+    };
+    if (!tipos_sem_uso.empty()) {
+        CasoTeste tentativa = sem_tipos(tipos_sem_uso);
+        if (falha(tentativa)) {
+            caso = std::move(tentativa);
+            return true;
+        }
+        for (const std::string& tipo : tipos_sem_uso) {
+            tentativa = sem_tipos({tipo});
+            if (falha(tentativa)) {
+                caso = std::move(tentativa);
+                return true;
+            }
+        }
+    }
+
+    // menos unidades funcionais e latências menores
+    for (auto membro : {&ConfigSimulador::unidades, &ConfigSimulador::unidadesMem, &ConfigSimulador::ciclos}) {
+        for (const auto& pair : caso.config.*membro) {
+            if (pair.second > 1) {
+                CasoTeste tentativa = caso;
+                (tentativa.config.*membro)[pair.first] = 1;
+                if (falha(tentativa)) {
+                    caso = std::move(tentativa);
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+ConfigSimulador geraConfigAleatoria(std::mt19937& rng) { // latências, unidades e extensões opcionais sorteadas
+    ConfigSimulador config;
+    std::uniform_int_distribution<int> latencia(1, 12);
+    std::uniform_int_distribution<int> quantidade(1, 3);
+
+    for (const char* tipo : {"Add", "Mult", "Div", "Integer"}) {
+        config.ciclos[tipo] = latencia(rng);
+        config.unidades[tipo] = quantidade(rng);
+    }
+    for (const char* tipo : {"Load", "Store"}) {
+        config.ciclos[tipo] = latencia(rng);
+        config.unidadesMem[tipo] = quantidade(rng);
+    }
+    for (const char* tipo : {"VAdd", "VMult", "VLoad", "VStore"}) {
+        config.ciclos[tipo] = latencia(rng);
+        config.unidades[tipo] = quantidade(rng);
+    }
+    config.comprimentoVetorMaximo = std::uniform_int_distribution<int>(1, 8)(rng);
+    config.encadeamento = std::uniform_int_distribution<int>(0, 1)(rng) == 1;
+
+    // metade dos casos com CDB limitado; desses, metade com prioridade por tipo na arbitragem
+    if (std::uniform_int_distribution<int>(0, 1)(rng) == 1) {
+        config.barramentosCDB = std::uniform_int_distribution<int>(1, 3)(rng);
+        if (std::uniform_int_distribution<int>(0, 1)(rng) == 1) {
+            std::vector<std::string> tipos = {"Add", "Mult", "Div", "Integer", "Load", "Store", "VAdd", "VMult", "VLoad", "VStore"};
+            std::shuffle(tipos.begin(), tipos.end(), rng);
+            tipos.resize(std::uniform_int_distribution<size_t>(1, tipos.size())(rng));
+            config.prioridadeCDB = tipos;
+        }
+    }
+
+    return config;
+}
+
+}
+
+std::string descreveTempo(const std::optional<int>& ciclo) {
+    return ciclo.has_value() ? std::to_string(ciclo.value()) : "---";
+}
+
+CasoTeste geraCasoAleatorio(std::mt19937& rng, int max_instrucoes) { // traço e configuração aleatórios
+    CasoTeste caso;
+    caso.config = geraConfigAleatoria(rng);
+    int num_instrucoes = std::uniform_int_distribution<int>(1, std::max(1, max_instrucoes))(rng);
+    for (int i = 0; i < num_instrucoes; ++i) {
+        caso.instrucoes.push_back(geraInstrucaoAleatoria(rng));
+    }
+    caso.config.numInstrucoes = num_instrucoes;
+    return caso;
+}
+
+CasoTeste geraCasoLaco(std::mt19937& rng, int max_instrucoes) { // corpo aleatório terminado em BNEZ e repetido várias vezes
+    CasoTeste caso;
+    caso.config = geraConfigAleatoria(rng);
+    caso.config.prioridadeCDB.clear(); // com CDB_PRIORITY o regime não extrapola
+
+    std::vector<InstrucaoInput> corpo;
+    int tamanho_corpo = std::uniform_int_distribution<int>(1, std::max(1, max_instrucoes / 3))(rng);
+    while (static_cast<int>(corpo.size()) < tamanho_corpo) {
+        InstrucaoInput instr = geraInstrucaoAleatoria(rng);
+        if (instr.d_operacao != "BNEZ" && instr.d_operacao != "BEQ") corpo.push_back(instr);
+    }
+    if (std::uniform_int_distribution<int>(0, 1)(rng) == 1) {
+        corpo.push_back({"DADDUI", "R1", "R1", "-8"}); // contador do laço
+    }
+    corpo.push_back({"BNEZ", "R1", "loop", ""});
+
+    // um prólogo opcional antes do laço, como em traços reais
+    int prologo = std::uniform_int_distribution<int>(0, 3)(rng);
+    for (int i = 0; i < prologo; ++i) {
+        InstrucaoInput instr = geraInstrucaoAleatoria(rng);
+        if (instr.d_operacao != "BNEZ" && instr.d_operacao != "BEQ") caso.instrucoes.push_back(instr);
+    }
+    int iteracoes = std::uniform_int_distribution<int>(4, 40)(rng);
+    for (int i = 0; i < iteracoes; ++i) {
+        caso.instrucoes.insert(caso.instrucoes.end(), corpo.begin(), corpo.end());
+    }
+    caso.config.numInstrucoes = caso.instrucoes.size();
+    return caso;
+}
+
+std::optional<Divergencia> comparaRegimeComCompleto(const CasoTeste& caso) { // extrapolação do regime permanente contra a simulação completa
+    Estado referencia(caso.config, caso.instrucoes);
+    Estado candidato(caso.config, caso.instrucoes);
+    const int limite_ciclos = referencia.limiteCiclosSeguro();
+    bool ref_terminou = referencia.executaAteTerminar(limite_ciclos);
+    executaComExtrapolacao(candidato, limite_ciclos);
+    bool cand_terminou = candidato.instrucoesEscritas >= candidato.estadoInstrucoes.size();
+
+    if (!ref_terminou || !cand_terminou) {
+        return Divergencia{referencia.clock_cycle, "limite de " + std::to_string(limite_ciclos) + " ciclos atingido sem terminar (referencia " +
+                                                   (ref_terminou ? "terminou" : "executando") + ", candidato " +
+                                                   (cand_terminou ? "terminou" : "executando") + ")"};
+    }
+    if (referencia.clock_cycle != candidato.clock_cycle) {
+        return Divergencia{referencia.clock_cycle, "termino: referencia no ciclo " + std::to_string(referencia.clock_cycle) +
+                                                   ", candidato no ciclo " + std::to_string(candidato.clock_cycle)};
+    }
+    for (size_t i = 0; i < referencia.estadoInstrucoes.size(); ++i) {
+        const auto& r = referencia.estadoInstrucoes[i];
+        const auto& c = candidato.estadoInstrucoes[i];
+        const std::pair<const char*, std::pair<std::optional<int>, std::optional<int>>> campos[] = {
+            {"issue", {r.issue, c.issue}},
+            {"exeCompleta", {r.exeCompleta, c.exeCompleta}},
+            {"write", {r.write, c.write}},
+        };
+        for (const auto& campo : campos) {
+            if (campo.second.first != campo.second.second) {
+                return Divergencia{referencia.clock_cycle, "instrucao " + std::to_string(i) + " (" + r.instrucao.operacao + ") campo " +
+                                                           campo.first + ": referencia " + descreveTempo(campo.second.first) +
+                                                           ", candidato " + descreveTempo(campo.second.second)};
+            }
+        }
+    }
+    if (referencia.estacaoRegistradores != candidato.estacaoRegistradores) {
+        return Divergencia{referencia.clock_cycle, "estacaoRegistradores final diferente"};
+    }
+    if (referencia.conflitosCDB != candidato.conflitosCDB) {
+        return Divergencia{referencia.clock_cycle, "conflitos de CDB: referencia " + std::to_string(referencia.conflitosCDB) +
+                                                   ", candidato " + std::to_string(candidato.conflitosCDB)};
+    }
+    return std::nullopt;
+}
+
+CasoTeste reduzCaso(const CasoTeste& caso, const PredicadoFalha& falha) { // encolhe o caso mantendo a falha
+    CasoTeste reduzido = caso;
+    while (reduzUmPasso(reduzido, falha)) {
+    }
+    reduzido.config.numInstrucoes = reduzido.instrucoes.size();
+    return reduzido;
+}
+
+ResultadoDiferencial executaVerificacaoDiferencial(int num_casos, unsigned semente, int max_instrucoes,
+                                                   const ComparadorMotores& compara, const GeradorCasos& gera) {
+    ResultadoDiferencial resultado;
+    std::mt19937 rng(semente);
+
+    for (int i = 0; i < num_casos; ++i) {
+        CasoTeste caso = gera(rng, max_instrucoes);
+        resultado.casosExecutados++;
+        if (compara(caso).has_value()) {
+            CasoTeste minimo = reduzCaso(caso, [&](const CasoTeste& c) { return compara(c).has_value(); });
+            resultado.divergencia = compara(minimo);
+            resultado.casoMinimo = std::move(minimo);
+            break;
+        }
+    }
+    return resultado;
+}
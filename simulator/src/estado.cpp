@@ -1,4 +1,5 @@
 #include "estado.hpp"
+#include "perfil.hpp"
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
@@ -43,25 +44,33 @@ Estado::Estado(const ConfigSimulador& cfg, const std::vector<InstrucaoInput>& in
     for (int i = 0; i < 32; ++i) {
         estacaoRegistradores["R" + std::to_string(i)] = std::nullopt;
     }
+    if (temUnidadesVetoriais()) {
+        for (int i = 0; i < 8; ++i) {
+            estacaoRegistradores["V" + std::to_string(i)] = std::nullopt;
+        }
+    }
+    registradorComprimentoVetor.assign(1, std::max(1, config.comprimentoVetorMaximo));
 }
 
 EstadoInstrucao* Estado::getNovaInstrucao() { // retorna a próxima instrução que ainda foi emitida 
-    for (auto& instr_state : estadoInstrucoes) {
-        if (!instr_state.issue.has_value()) {
-            return &instr_state;
-        }
+    while (proximaEmissao < estadoInstrucoes.size() && estadoInstrucoes[proximaEmissao].issue.has_value()) {
+        proximaEmissao++;
     }
-    return nullptr;
+    return proximaEmissao < estadoInstrucoes.size() ? &estadoInstrucoes[proximaEmissao] : nullptr;
 }
 
-std::string Estado::verificaUFInstrucao(const InstrucaoDetalhes& instr_details) { //mapeia a operação para a unidade funcional capaz de executá-la
+std::string Estado::verificaUFInstrucao(const InstrucaoDetalhes& instr_details) const { //mapeia a operação para a unidade funcional capaz de executá-la
     const std::string& op = instr_details.operacao;
     if (op == "ADDD" || op == "SUBD") return "Add";
     if (op == "MULTD") return "Mult";
     if (op == "DIVD") return "Div";
     if (op == "LD") return "Load";
     if (op == "SD") return "Store";
-    if (op == "ADD" || op == "DADDUI" || op == "BEQ" || op == "BNEZ") return "Integer";
+    if (op == "ADD" || op == "DADDUI" || op == "BEQ" || op == "BNEZ" || op == "SETVL") return "Integer";
+    if (op == "ADDV" || op == "SUBV") return "VAdd";
+    if (op == "MULV") return "VMult";
+    if (op == "LV") return "VLoad";
+    if (op == "SV") return "VStore";
     std::cerr << "WARN: Unknown operation for UF check: " << op << std::endl;
     return "";
 }
@@ -86,7 +95,7 @@ UnidadeFuncionalMemoria* Estado::getFUVaziaMem(const std::string& tipoFU) {
     return nullptr;
 }
 
-int Estado::getCiclos(const InstrucaoDetalhes& instr_details) { //retorna o número de ciclos que a instrução gasta
+int Estado::getCiclos(const InstrucaoDetalhes& instr_details) const { //retorna o número de ciclos que a instrução gasta
     const std::string& op_type = verificaUFInstrucao(instr_details);
     if (config.ciclos.count(op_type)) {
         return config.ciclos.at(op_type);
@@ -103,12 +112,14 @@ void Estado::alocaFU(UnidadeFuncional& uf, const InstrucaoDetalhes& instr_detail
     uf.tempo = getCiclos(instr_details) + 1;
     uf.ocupado = true;
     uf.operacao = instr_details.operacao;
+    uf.comprimentoVetor = std::nullopt;
     uf.vj = std::nullopt;
     uf.vk = std::nullopt;
     uf.qj = std::nullopt;
     uf.qk = std::nullopt;
 
-    std::string src_reg_j_name, src_reg_k_name;
+    const auto& registradores = tabelaRegistradores(estado_instr_orig);
+    const std::vector<std::string> fontes = registradoresFonte(instr_details);
 
     if (instr_details.operacao == "ADDD" || instr_details.operacao == "SUBD") {
         if (uf.tempo.has_value() && uf.tempo.value() > 0) {
@@ -116,12 +127,10 @@ void Estado::alocaFU(UnidadeFuncional& uf, const InstrucaoDetalhes& instr_detail
         }
     }
 
-    if (instr_details.operacao == "BNEZ" || instr_details.operacao == "BEQ") {
-        src_reg_j_name = instr_details.registradorR;
-        src_reg_k_name = instr_details.registradorS;
-    } else {
-        src_reg_j_name = instr_details.registradorS;
-        src_reg_k_name = instr_details.registradorT;
+    if (ehOperacaoVetorial(instr_details.operacao)) {
+        // unidade vetorial em pipeline: latência de partida e depois um elemento por ciclo
+        uf.comprimentoVetor = registradorComprimentoVetor[estado_instr_orig.thread];
+        uf.tempo = uf.tempo.value() + uf.comprimentoVetor.value() - 1;
     }
 
     auto setup_operand = [&](std::optional<std::string>& v_val, std::optional<std::string>& q_val, const std::string& reg_name) {
@@ -130,17 +139,17 @@ void Estado::alocaFU(UnidadeFuncional& uf, const InstrucaoDetalhes& instr_detail
             return;
         }
         bool is_immediate = true;
-        if (reg_name.empty() || (!reg_name.empty() && (reg_name[0] == 'F' || reg_name[0] == 'R'))) {
+        if (reg_name.empty() || (!reg_name.empty() && (reg_name[0] == 'F' || reg_name[0] == 'R' || reg_name[0] == 'V'))) {
             is_immediate = false;
             for(char c : reg_name)
-                if (reg_name.length() > 1 && isalpha(c) && c != 'F' && c != 'R')
+                if (reg_name.length() > 1 && isalpha(c) && c != 'F' && c != 'R' && c != 'V')
                     is_immediate = true;
         }
 
-        if (is_immediate && !(reg_name[0] == 'F' || reg_name[0] == 'R')) {
+        if (is_immediate && !(reg_name[0] == 'F' || reg_name[0] == 'R' || reg_name[0] == 'V')) {
             v_val = reg_name;
-        } else if (estacaoRegistradores.count(reg_name)) {
-            const auto& reg_status = estacaoRegistradores.at(reg_name);
+        } else if (registradores.count(reg_name)) {
+            const auto& reg_status = registradores.at(reg_name);
             if (!reg_status.has_value() || reg_status.value().rfind("VAL(", 0) == 0) {
                 v_val = reg_status.has_value() ? reg_status.value() : reg_name;
             } else {
@@ -156,8 +165,8 @@ void Estado::alocaFU(UnidadeFuncional& uf, const InstrucaoDetalhes& instr_detail
         }
     };
 
-    setup_operand(uf.vj, uf.qj, src_reg_j_name);
-    setup_operand(uf.vk, uf.qk, src_reg_k_name);
+    setup_operand(uf.vj, uf.qj, fontes[0]);
+    setup_operand(uf.vk, uf.qk, fontes[1]);
 }
 
 void Estado::alocaFuMem(UnidadeFuncionalMemoria& uf_mem, const InstrucaoDetalhes& instr_details, EstadoInstrucao& estado_instr_orig) { // aloca uma unidade funcional para a instrução
@@ -171,40 +180,74 @@ void Estado::alocaFuMem(UnidadeFuncionalMemoria& uf_mem, const InstrucaoDetalhes
     uf_mem.qi = std::nullopt;
     uf_mem.qj = std::nullopt;
 
-    if (instr_details.operacao == "SD") {
-        if (estacaoRegistradores.count(instr_details.registradorR)) {
-            const auto& producing_fu_name_opt = estacaoRegistradores.at(instr_details.registradorR);
-            if (producing_fu_name_opt.has_value()) {
-                const std::string& producing_fu_name = producing_fu_name_opt.value();
-                if (unidadesFuncionais.count(producing_fu_name) || unidadesFuncionaisMemoria.count(producing_fu_name)) {
-                    uf_mem.qi = producing_fu_name;
-                }
-            }
-        }
-    }
+    const auto& registradores = tabelaRegistradores(estado_instr_orig);
+    const std::vector<std::string> fontes = registradoresFonte(instr_details); // valor armazenado (só SD) e base
 
-    if (estacaoRegistradores.count(instr_details.registradorT)) {
-        const auto& producing_fu_name_opt = estacaoRegistradores.at(instr_details.registradorT);
+    auto setup_tag = [&](std::optional<std::string>& q_val, const std::string& reg_name) {
+        if (!registradores.count(reg_name)) return;
+        const auto& producing_fu_name_opt = registradores.at(reg_name);
         if (producing_fu_name_opt.has_value()) {
             const std::string& producing_fu_name = producing_fu_name_opt.value();
             if (unidadesFuncionais.count(producing_fu_name) || unidadesFuncionaisMemoria.count(producing_fu_name)) {
-                uf_mem.qj = producing_fu_name;
+                q_val = producing_fu_name;
             }
         }
+    };
+
+    setup_tag(uf_mem.qi, fontes[0]);
+    setup_tag(uf_mem.qj, fontes[1]);
+}
+
+bool Estado::ehOperacaoVetorial(const std::string& operacao) { //ADDV, SUBV, MULV, LV e SV
+    return operacao == "ADDV" || operacao == "SUBV" || operacao == "MULV" || operacao == "LV" || operacao == "SV";
+}
+
+bool Estado::temUnidadesVetoriais() const { //alguma unidade VAdd/VMult/VLoad/VStore configurada
+    for (const auto& pair : config.unidades) {
+        if (pair.second > 0 && (pair.first == "VAdd" || pair.first == "VMult" || pair.first == "VLoad" || pair.first == "VStore")) {
+            return true;
+        }
     }
+    return false;
 }
 
-void Estado::escreveEstacaoRegistrador(const InstrucaoDetalhes& instr_details, const std::string& ufNome) { //informa ao registrador final qual unidade funcional irá lhe entregar o resultado da operação
-    if (instr_details.operacao != "SD" && instr_details.operacao != "BEQ" && instr_details.operacao != "BNEZ") {
+std::vector<std::string> Estado::registradoresFonte(const InstrucaoDetalhes& instr_details) { //operandos lidos pela instrução: {Qj, Qk} em alocaFU, {Qi, Qj} em alocaFuMem ("" = sem operando)
+    const std::string& op = instr_details.operacao;
+    if (op == "LD") return {"", instr_details.registradorT};
+    if (op == "SD" || op == "SV") return {instr_details.registradorR, instr_details.registradorT};
+    if (op == "SETVL") return {"", ""};
+    if (op == "BNEZ" || op == "BEQ") return {instr_details.registradorR, instr_details.registradorS};
+    return {instr_details.registradorS, instr_details.registradorT};
+}
+
+std::optional<std::string> Estado::registradorDestino(const InstrucaoDetalhes& instr_details) { //registrador escrito pela instrução (nenhum para SD e desvios)
+    const std::string& op = instr_details.operacao;
+    if (op != "SD" && op != "SV" && op != "BEQ" && op != "BNEZ" && op != "SETVL") {
         if (!instr_details.registradorR.empty()) {
-            estacaoRegistradores[instr_details.registradorR] = ufNome;
+            return instr_details.registradorR;
         }
     }
+    return std::nullopt;
+}
+
+void Estado::escreveEstacaoRegistrador(const EstadoInstrucao& estado_instr, const std::string& ufNome) { //informa ao registrador final qual unidade funcional irá lhe entregar o resultado da operação
+    std::optional<std::string> destino = registradorDestino(estado_instr.instrucao);
+    if (destino.has_value()) {
+        tabelaRegistradores(estado_instr)[destino.value()] = ufNome;
+    }
+}
+
+TabelaRegistradores& Estado::tabelaRegistradores(const EstadoInstrucao&) { //tabela de status de registradores vista pela instrução
+    return estacaoRegistradores;
+}
+
+void Estado::aoEscreverInstrucao(EstadoInstrucao&) { //chamado logo após a instrução receber seu ciclo de escrita
 }
 
 
 
 void Estado::liberaUFEsperandoResultado(const std::string& nomeUFQueTerminou) { //libera dependeências que estavam esperando a liberação da unidade funcional
+    PERFIL_ESTAGIO(Liberacao);
     std::string val_representation = "VAL(" + nomeUFQueTerminou + ")";
 
     for (auto& pair : unidadesFuncionais) {
@@ -276,6 +319,7 @@ void Estado::desalocaUF(UnidadeFuncional& uf) {
     uf.tempo = std::nullopt;
     uf.ocupado = false;
     uf.operacao = std::nullopt;
+    uf.comprimentoVetor = std::nullopt;
     uf.vj = std::nullopt;
     uf.vk = std::nullopt;
     uf.qj = std::nullopt;
@@ -283,46 +327,50 @@ void Estado::desalocaUF(UnidadeFuncional& uf) {
 }
 
 bool Estado::verificaSeJaTerminou() { //retorna true se todas as instruções do arquivo de entrada tiverem escrito seus resultados
-    if (estadoInstrucoes.empty()) return true;
-    for (const auto& instr_state : estadoInstrucoes) {
-        if (!instr_state.write.has_value()) {
-            return false;
-        }
-    }
-    return true;
+    return instrucoesEscritas >= estadoInstrucoes.size();
 }
 
 void Estado::issueNovaInstrucao() { //busca a nova instrução, procura uma unidade funcional para alocá-la e marca o ciclo de emissão da instrução
     EstadoInstrucao* nova_instr_estado = getNovaInstrucao();
     if (nova_instr_estado) {
-        std::string tipoFU_str = verificaUFInstrucao(nova_instr_estado->instrucao);
-        if (tipoFU_str.empty()){
-            std::cerr << "ERROR: Cannot determine FU type for " << nova_instr_estado->instrucao.operacao << std::endl;
-            return;
-        }
+        emiteInstrucao(*nova_instr_estado);
+    }
+}
 
-        if (tipoFU_str == "Load" || tipoFU_str == "Store") {
-            UnidadeFuncionalMemoria* uf_para_usar = getFUVaziaMem(tipoFU_str);
-            if (uf_para_usar) {
-                alocaFuMem(*uf_para_usar, nova_instr_estado->instrucao, *nova_instr_estado);
-                nova_instr_estado->issue = clock_cycle;
-                if (uf_para_usar->instrucao_details.has_value() &&
-                    uf_para_usar->instrucao_details.value().operacao != "SD") {
-                    escreveEstacaoRegistrador(nova_instr_estado->instrucao, uf_para_usar->nome);
-                }
+bool Estado::emiteInstrucao(EstadoInstrucao& nova_instr_estado) { //aloca uma unidade funcional livre para a instrução e marca o ciclo de emissão
+    std::string tipoFU_str = verificaUFInstrucao(nova_instr_estado.instrucao);
+    if (tipoFU_str.empty()){
+        std::cerr << "ERROR: Cannot determine FU type for " << nova_instr_estado.instrucao.operacao << std::endl;
+        return false;
+    }
+
+    if (tipoFU_str == "Load" || tipoFU_str == "Store") {
+        UnidadeFuncionalMemoria* uf_para_usar = getFUVaziaMem(tipoFU_str);
+        if (uf_para_usar) {
+            alocaFuMem(*uf_para_usar, nova_instr_estado.instrucao, nova_instr_estado);
+            nova_instr_estado.issue = clock_cycle;
+            if (uf_para_usar->instrucao_details.has_value() &&
+                uf_para_usar->instrucao_details.value().operacao != "SD") {
+                escreveEstacaoRegistrador(nova_instr_estado, uf_para_usar->nome);
             }
-        } else {
-            UnidadeFuncional* uf_para_usar = getFUVaziaArithInt(tipoFU_str);
-            if (uf_para_usar) {
-                alocaFU(*uf_para_usar, nova_instr_estado->instrucao, *nova_instr_estado);
-                nova_instr_estado->issue = clock_cycle;
-                const auto& op = nova_instr_estado->instrucao.operacao;
-                if (op != "BEQ" && op != "BNEZ") {
-                    escreveEstacaoRegistrador(nova_instr_estado->instrucao, uf_para_usar->nome);
-                }
+            return true;
+        }
+    } else {
+        UnidadeFuncional* uf_para_usar = getFUVaziaArithInt(tipoFU_str);
+        if (uf_para_usar) {
+            alocaFU(*uf_para_usar, nova_instr_estado.instrucao, nova_instr_estado);
+            nova_instr_estado.issue = clock_cycle;
+            const auto& op = nova_instr_estado.instrucao.operacao;
+            if (op == "SETVL") {
+                // a emissão é em ordem, então as operações vetoriais seguintes já enxergam o novo comprimento
+                defineComprimentoVetor(nova_instr_estado);
+            } else if (op != "BEQ" && op != "BNEZ") {
+                escreveEstacaoRegistrador(nova_instr_estado, uf_para_usar->nome);
             }
+            return true;
         }
     }
+    return false;
 }
 
 void Estado::executaInstrucao() { //verifica se a unidade funcional não tem dependências, decrementa o tempo restante de execução e marca o ciclo de término da instrução
@@ -366,62 +414,204 @@ void Estado::executaInstrucao() { //verifica se a unidade funcional não tem dep
             }
         }
     }
+
+    if (config.encadeamento) {
+        encadeiaOperacoesVetoriais();
+    }
+}
+
+void Estado::encadeiaOperacoesVetoriais() { //libera operandos vetoriais cujo produtor já entregou o primeiro elemento
+    auto produziu_primeiro_elemento = [&](const std::string& nome_produtor) {
+        auto it = unidadesFuncionais.find(nome_produtor);
+        if (it == unidadesFuncionais.end()) return false;
+        const UnidadeFuncional& produtor = it->second;
+        if (!produtor.ocupado || !produtor.comprimentoVetor.has_value() || produtor.operacao == "SV" || !produtor.tempo.has_value()) {
+            return false;
+        }
+        if (produtor.tempo.value() == -1) return true;
+        // restam no máximo comprimentoVetor - 1 elementos: a latência de partida já passou
+        return produtor.estadoInstrucaoOriginal && produtor.estadoInstrucaoOriginal->busy &&
+               produtor.tempo.value() < produtor.comprimentoVetor.value();
+    };
+
+    for (auto& pair : unidadesFuncionais) {
+        UnidadeFuncional& uf = pair.second;
+        if (!uf.ocupado || !uf.comprimentoVetor.has_value()) continue;
+        bool encadeou = false;
+        if (uf.qj.has_value() && produziu_primeiro_elemento(uf.qj.value())) {
+            uf.vj = "CHAIN(" + uf.qj.value() + ")";
+            uf.qj = std::nullopt;
+            encadeou = true;
+        }
+        if (uf.qk.has_value() && produziu_primeiro_elemento(uf.qk.value())) {
+            uf.vk = "CHAIN(" + uf.qk.value() + ")";
+            uf.qk = std::nullopt;
+            encadeou = true;
+        }
+        // mesmo desconto de um ciclo que liberaUFEsperandoResultado aplica quando a última dependência é resolvida
+        if (encadeou && !uf.qj.has_value() && !uf.qk.has_value() && uf.tempo.has_value() && uf.tempo.value() > 0) {
+            uf.tempo = uf.tempo.value() - 1;
+        }
+    }
+}
+
+int Estado::comprimentoSETVL(const InstrucaoDetalhes& instr_details, int comprimento_maximo) { //comprimento pedido por um SETVL, limitado a [1, VLEN]
+    int comprimento = comprimento_maximo;
+    try {
+        comprimento = std::stoi(instr_details.registradorR);
+    } catch (const std::exception&) {
+        std::cerr << "WARN: SETVL expects an immediate length, got '" << instr_details.registradorR << "'" << std::endl;
+    }
+    return std::max(1, std::min(comprimento, comprimento_maximo));
+}
+
+void Estado::defineComprimentoVetor(const EstadoInstrucao& estado_instr) { //SETVL: atualiza o registrador de comprimento vetorial da thread
+    registradorComprimentoVetor[estado_instr.thread] = comprimentoSETVL(estado_instr.instrucao, std::max(1, config.comprimentoVetorMaximo));
 }
 
 void Estado::escreveInstrucao() { //registra o resultado da instrução em seu registrador de destino
+    if (config.barramentosCDB <= 0) { // CDB ilimitado: todas as unidades prontas escrevem no mesmo ciclo
+        for (auto& pair : unidadesFuncionaisMemoria) {
+            if (prontaParaEscrever(pair.second.estadoInstrucaoOriginal, pair.second.tempo)) {
+                escreveResultadoMem(pair.second);
+            }
+        }
+        for (auto& pair : unidadesFuncionais) {
+            if (prontaParaEscrever(pair.second.estadoInstrucaoOriginal, pair.second.tempo)) {
+                escreveResultado(pair.second);
+            }
+        }
+        return;
+    }
+
+    struct PedidoCDB {
+        const EstadoInstrucao* instrucao;
+        int prioridade; // posição do tipo em CDB_PRIORITY (tipos ausentes depois de todos)
+        UnidadeFuncional* uf;
+        UnidadeFuncionalMemoria* uf_mem;
+    };
+    auto prioridade_tipo = [&](const std::string& tipo) {
+        auto it = std::find(config.prioridadeCDB.begin(), config.prioridadeCDB.end(), tipo);
+        return static_cast<int>(it - config.prioridadeCDB.begin());
+    };
+
+    // SD, SV, desvios e SETVL não difundem valor: terminam sem disputar um barramento
+    std::vector<PedidoCDB> pedidos;
     for (auto& pair : unidadesFuncionaisMemoria) {
         UnidadeFuncionalMemoria& uf_mem = pair.second;
-        if (uf_mem.ocupado && uf_mem.tempo.has_value() && uf_mem.tempo.value() == -1 &&
-            uf_mem.estadoInstrucaoOriginal && !uf_mem.estadoInstrucaoOriginal->write.has_value() &&
-            uf_mem.estadoInstrucaoOriginal->exeCompleta.has_value() &&
-            uf_mem.estadoInstrucaoOriginal->exeCompleta.value() < clock_cycle) {
-            uf_mem.estadoInstrucaoOriginal->write = clock_cycle;
-            if (uf_mem.instrucao_details.has_value()) {
-                const auto& instr_d = uf_mem.instrucao_details.value();
-                if (instr_d.operacao != "SD") {
-                    if (estacaoRegistradores.count(instr_d.registradorR)) {
-                        auto& reg_status = estacaoRegistradores.at(instr_d.registradorR);
-                        if (reg_status.has_value() && reg_status.value() == uf_mem.nome) {
-                            reg_status = "VAL(" + uf_mem.nome + ")";
-                        }
-                    }
+        if (!prontaParaEscrever(uf_mem.estadoInstrucaoOriginal, uf_mem.tempo)) continue;
+        if (registradorDestino(uf_mem.estadoInstrucaoOriginal->instrucao).has_value()) {
+            pedidos.push_back({uf_mem.estadoInstrucaoOriginal, prioridade_tipo(uf_mem.tipoUnidade), nullptr, &uf_mem});
+        } else {
+            escreveResultadoMem(uf_mem);
+        }
+    }
+    for (auto& pair : unidadesFuncionais) {
+        UnidadeFuncional& uf = pair.second;
+        if (!prontaParaEscrever(uf.estadoInstrucaoOriginal, uf.tempo)) continue;
+        if (registradorDestino(uf.estadoInstrucaoOriginal->instrucao).has_value()) {
+            pedidos.push_back({uf.estadoInstrucaoOriginal, prioridade_tipo(uf.tipoUnidade), &uf, nullptr});
+        } else {
+            escreveResultado(uf);
+        }
+    }
+
+    // arbitragem: prioridade do tipo (se configurada) e depois a instrução mais antiga; a emissão é
+    // de uma instrução por ciclo, então o ciclo de issue ordena as instruções de todas as threads
+    std::sort(pedidos.begin(), pedidos.end(), [](const PedidoCDB& a, const PedidoCDB& b) {
+        if (a.prioridade != b.prioridade) return a.prioridade < b.prioridade;
+        return a.instrucao->issue.value() < b.instrucao->issue.value();
+    });
+
+    // os vencedores escrevem na ordem arbitrada, e os dependentes acordam nessa mesma ordem;
+    // os demais continuam prontos e tentam de novo no próximo ciclo
+    const size_t vencedores = std::min(pedidos.size(), static_cast<size_t>(config.barramentosCDB));
+    for (size_t i = 0; i < vencedores; ++i) {
+        if (pedidos[i].uf) {
+            escreveResultado(*pedidos[i].uf);
+        } else {
+            escreveResultadoMem(*pedidos[i].uf_mem);
+        }
+    }
+    conflitosCDB += static_cast<int>(pedidos.size() - vencedores);
+}
+
+bool Estado::prontaParaEscrever(const EstadoInstrucao* estado_instr, const std::optional<int>& tempo) const { //execução terminou em um ciclo anterior e o resultado ainda não foi escrito
+    return estado_instr && tempo.has_value() && tempo.value() == -1 && !estado_instr->write.has_value() &&
+           estado_instr->exeCompleta.has_value() && estado_instr->exeCompleta.value() < clock_cycle;
+}
+
+void Estado::escreveResultadoMem(UnidadeFuncionalMemoria& uf_mem) {
+    uf_mem.estadoInstrucaoOriginal->write = clock_cycle;
+    instrucoesEscritas++;
+    aoEscreverInstrucao(*uf_mem.estadoInstrucaoOriginal);
+    auto& registradores = tabelaRegistradores(*uf_mem.estadoInstrucaoOriginal);
+    if (uf_mem.instrucao_details.has_value()) {
+        const auto& instr_d = uf_mem.instrucao_details.value();
+        if (instr_d.operacao != "SD") {
+            if (registradores.count(instr_d.registradorR)) {
+                auto& reg_status = registradores.at(instr_d.registradorR);
+                if (reg_status.has_value() && reg_status.value() == uf_mem.nome) {
+                    reg_status = "VAL(" + uf_mem.nome + ")";
                 }
             }
-            liberaUFEsperandoResultado(uf_mem.nome);
-            desalocaUFMem(uf_mem);
         }
     }
+    liberaUFEsperandoResultado(uf_mem.nome);
+    desalocaUFMem(uf_mem);
+}
 
-    for (auto& pair : unidadesFuncionais) {
-        UnidadeFuncional& uf = pair.second;
-        if (uf.ocupado && uf.tempo.has_value() && uf.tempo.value() == -1 &&
-            uf.estadoInstrucaoOriginal && !uf.estadoInstrucaoOriginal->write.has_value() &&
-            uf.estadoInstrucaoOriginal->exeCompleta.has_value() &&
-            uf.estadoInstrucaoOriginal->exeCompleta.value() < clock_cycle) {
-            uf.estadoInstrucaoOriginal->write = clock_cycle;
-            if (uf.instrucao_details.has_value()) {
-                const auto& instr_d = uf.instrucao_details.value();
-                if (instr_d.operacao != "BEQ" && instr_d.operacao != "BNEZ") {
-                    if (estacaoRegistradores.count(instr_d.registradorR)) {
-                        auto& reg_status = estacaoRegistradores.at(instr_d.registradorR);
-                        if (reg_status.has_value() && reg_status.value() == uf.nome) {
-                            reg_status = "VAL(" + uf.nome + ")";
-                        }
-                    }
+void Estado::escreveResultado(UnidadeFuncional& uf) { //escrita no CDB: marca o ciclo, atualiza o registrador, acorda dependentes e libera a unidade
+    uf.estadoInstrucaoOriginal->write = clock_cycle;
+    instrucoesEscritas++;
+    aoEscreverInstrucao(*uf.estadoInstrucaoOriginal);
+    auto& registradores = tabelaRegistradores(*uf.estadoInstrucaoOriginal);
+    if (uf.instrucao_details.has_value()) {
+        const auto& instr_d = uf.instrucao_details.value();
+        if (instr_d.operacao != "BEQ" && instr_d.operacao != "BNEZ") {
+            if (registradores.count(instr_d.registradorR)) {
+                auto& reg_status = registradores.at(instr_d.registradorR);
+                if (reg_status.has_value() && reg_status.value() == uf.nome) {
+                    reg_status = "VAL(" + uf.nome + ")";
                 }
             }
-            liberaUFEsperandoResultado(uf.nome);
-            desalocaUF(uf);
         }
     }
+    liberaUFEsperandoResultado(uf.nome);
+    desalocaUF(uf);
 }
 
 bool Estado::executa_ciclo() { //exxecuta um ciclo completo
+    PERFIL_INICIA_CICLO();
     clock_cycle++;
     issueNovaInstrucao();
+    PERFIL_MARCA(Issue);
     executaInstrucao();
+    PERFIL_MARCA(Execucao);
     escreveInstrucao();
-    return verificaSeJaTerminou();
+    PERFIL_MARCA(Escrita);
+    bool terminou = verificaSeJaTerminou();
+    PERFIL_FECHA_CICLO();
+    return terminou;
+}
+
+bool Estado::executaAteTerminar(int limite_ciclos) { //executa ciclos até todas as instruções escreverem ou o limite ser atingido
+    bool terminou = verificaSeJaTerminou();
+    while (!terminou && clock_cycle < limite_ciclos) {
+        terminou = executa_ciclo();
+    }
+    return terminou;
+}
+
+int Estado::limiteCiclosSeguro() const { //limite superior de ciclos para o traço atual (execução totalmente serializada)
+    int maior_latencia = 1;
+    for (const auto& pair : config.ciclos) {
+        maior_latencia = std::max(maior_latencia, pair.second);
+    }
+    if (temUnidadesVetoriais()) {
+        maior_latencia += config.comprimentoVetorMaximo;
+    }
+    return static_cast<int>(estadoInstrucoes.size()) * (maior_latencia + 3) + 10;
 }
 
 void Estado::printEstadoDebug() const { //imprime o estado das instruções, unidades funcionais, memória e registradores
@@ -443,7 +633,11 @@ void Estado::printEstadoDebug() const { //imprime o estado das instruções, uni
     
     std::cout << "  |  Emitidas: " << emitidas 
               << "  |  Executando: " << executando 
-              << "  |  Completas: " << completas << " / " << estadoInstrucoes.size() << std::endl;
+              << "  |  Completas: " << completas << " / " << estadoInstrucoes.size();
+    if (config.barramentosCDB > 0) {
+        std::cout << "  |  Conflitos CDB: " << conflitosCDB;
+    }
+    std::cout << std::endl;
     std::cout << std::string(100, '=') << std::endl;
     
     // ========== TABELA 1: Status das Instruções ==========
@@ -595,6 +789,34 @@ void Estado::printEstadoDebug() const { //imprime o estado das instruções, uni
         }
     }
     if (count % 5 != 0) std::cout << std::endl;
+
+    // Registradores Vetoriais (V0-V7) e VLR, apenas com unidades vetoriais configuradas
+    if (temUnidadesVetoriais()) {
+        std::cout << std::string(100, '-') << std::endl;
+        std::cout << "VETORIAL (V0-V7)  |  VLR: " << registradorComprimentoVetor[0] << std::endl;
+        std::cout << std::string(100, '-') << std::endl;
+
+        count = 0;
+        for (int i = 0; i < 8; i++) {
+            std::string reg_name = "V" + std::to_string(i);
+            std::string valor = estacaoRegistradores.at(reg_name).has_value()
+                                ? estacaoRegistradores.at(reg_name).value()
+                                : "init";
+
+            if (valor.length() > 10) valor = valor.substr(0, 10);
+
+            std::cout << std::setw(4) << std::right << reg_name << ": "
+                      << std::setw(12) << std::left << valor;
+
+            count++;
+            if (count % 5 == 0) {
+                std::cout << std::endl;
+            } else {
+                std::cout << " | ";
+            }
+        }
+        if (count % 5 != 0) std::cout << std::endl;
+    }
     
     std::cout << std::string(100, '=') << std::endl;
 }
\ No newline at end of file
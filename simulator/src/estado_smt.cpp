@@ -0,0 +1,173 @@
+#include "estado_smt.hpp"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+
+namespace {
+
+std::vector<InstrucaoInput> concatenaTracos(const std::vector<std::vector<InstrucaoInput>>& tracos) {
+    std::vector<InstrucaoInput> todas;
+    for (const auto& traco : tracos) {
+        todas.insert(todas.end(), traco.begin(), traco.end());
+    }
+    return todas;
+}
+
+}
+
+bool parsePoliticaEmissao(const std::string& nome, PoliticaEmissao& politica) { // "rr" ou "icount"
+    if (nome == "rr") {
+        politica = PoliticaEmissao::RoundRobin;
+        return true;
+    }
+    if (nome == "icount") {
+        politica = PoliticaEmissao::ICount;
+        return true;
+    }
+    return false;
+}
+
+bool mesmaMaquina(const ConfigSimulador& a, const ConfigSimulador& b) { // mesma configuração de hardware (ignora numInstrucoes)
+    return a.ciclos == b.ciclos && a.unidades == b.unidades && a.unidadesMem == b.unidadesMem &&
+           a.comprimentoVetorMaximo == b.comprimentoVetorMaximo && a.encadeamento == b.encadeamento &&
+           a.barramentosCDB == b.barramentosCDB && a.prioridadeCDB == b.prioridadeCDB;
+}
+
+bool semConfigMaquina(const ConfigSimulador& config) { // arquivo sem nenhuma chave de máquina: herda a máquina do primeiro traço
+    return mesmaMaquina(config, ConfigSimulador());
+}
+
+EstadoSMT::EstadoSMT(const ConfigSimulador& cfg, const std::vector<std::vector<InstrucaoInput>>& tracos, PoliticaEmissao politica_emissao)
+    : Estado(cfg, concatenaTracos(tracos)), politica(politica_emissao) {
+    size_t inicio = 0;
+    for (size_t t = 0; t < tracos.size(); ++t) {
+        ContextoThread contexto;
+        contexto.estacaoRegistradores = estacaoRegistradores;
+        contexto.inicio = inicio;
+        contexto.fim = inicio + tracos[t].size();
+        contexto.proximaEmissao = inicio;
+        for (size_t i = contexto.inicio; i < contexto.fim; ++i) {
+            estadoInstrucoes[i].thread = static_cast<int>(t);
+        }
+        threads.push_back(contexto);
+        inicio = contexto.fim;
+    }
+    registradorComprimentoVetor.assign(threads.size(), registradorComprimentoVetor[0]);
+}
+
+std::vector<size_t> EstadoSMT::ordemDeTentativa() const { // ordem em que as threads tentam emitir neste ciclo
+    std::vector<size_t> ordem;
+    for (size_t k = 0; k < threads.size(); ++k) {
+        ordem.push_back((proximaThread + k) % threads.size());
+    }
+    if (politica == PoliticaEmissao::ICount) {
+        // empates ficam na ordem do round-robin, para nenhuma thread ser sempre preterida
+        std::stable_sort(ordem.begin(), ordem.end(), [&](size_t a, size_t b) {
+            return threads[a].emVoo < threads[b].emVoo;
+        });
+    }
+    return ordem;
+}
+
+void EstadoSMT::amostraOcupacao() {
+    for (const auto& pair : unidadesFuncionais) {
+        if (pair.second.ocupado) ocupacaoPorTipo[pair.second.tipoUnidade]++;
+    }
+    for (const auto& pair : unidadesFuncionaisMemoria) {
+        if (pair.second.ocupado) ocupacaoPorTipo[pair.second.tipoUnidade]++;
+    }
+}
+
+void EstadoSMT::issueNovaInstrucao() { //escolhe a thread pela política e emite no máximo uma instrução por ciclo
+    amostraOcupacao();
+
+    bool emitiu = false;
+    for (size_t t : ordemDeTentativa()) {
+        ContextoThread& contexto = threads[t];
+        if (contexto.proximaEmissao >= contexto.fim) continue;
+
+        if (emitiu) {
+            contexto.ciclosSemVez++;
+            continue;
+        }
+
+        EstadoInstrucao& instr = estadoInstrucoes[contexto.proximaEmissao];
+        if (emiteInstrucao(instr)) {
+            contexto.proximaEmissao++;
+            contexto.emVoo++;
+            proximaThread = (t + 1) % threads.size();
+            emitiu = true;
+        } else {
+            contexto.bloqueiosEstruturais++;
+            bloqueiosPorTipo[verificaUFInstrucao(instr.instrucao)]++;
+        }
+    }
+}
+
+TabelaRegistradores& EstadoSMT::tabelaRegistradores(const EstadoInstrucao& estado_instr) {
+    return threads[estado_instr.thread].estacaoRegistradores;
+}
+
+void EstadoSMT::aoEscreverInstrucao(EstadoInstrucao& estado_instr) {
+    ContextoThread& contexto = threads[estado_instr.thread];
+    contexto.emVoo--;
+    contexto.escritas++;
+    contexto.ultimaEscrita = clock_cycle;
+}
+
+void EstadoSMT::imprimeRelatorioSMT() const { // IPC por thread e agregado, e disputa pelas unidades funcionais
+    std::cout << "\n[ SMT - " << threads.size() << " THREADS, POLITICA "
+              << (politica == PoliticaEmissao::ICount ? "ICOUNT" : "ROUND-ROBIN") << " ]" << std::endl;
+    std::cout << std::string(90, '-') << std::endl;
+    std::cout << std::left
+              << std::setw(8) << "Thread"
+              << std::setw(14) << "Instrucoes"
+              << std::setw(12) << "Termino"
+              << std::setw(10) << "IPC"
+              << std::setw(22) << "Bloqueio estrutural"
+              << std::setw(16) << "Sem vez" << std::endl;
+    std::cout << std::string(90, '-') << std::endl;
+
+    for (size_t t = 0; t < threads.size(); ++t) {
+        const ContextoThread& contexto = threads[t];
+        int instrucoes = static_cast<int>(contexto.fim - contexto.inicio);
+        double ipc = contexto.ultimaEscrita > 0 ? static_cast<double>(contexto.escritas) / contexto.ultimaEscrita : 0.0;
+        std::cout << std::left
+                  << std::setw(8) << t
+                  << std::setw(14) << instrucoes
+                  << std::setw(12) << contexto.ultimaEscrita
+                  << std::setw(10) << std::fixed << std::setprecision(3) << ipc
+                  << std::setw(22) << contexto.bloqueiosEstruturais
+                  << std::setw(16) << contexto.ciclosSemVez << std::endl;
+    }
+    std::cout << std::string(90, '-') << std::endl;
+
+    double ipc_agregado = clock_cycle > 0 ? static_cast<double>(instrucoesEscritas) / clock_cycle : 0.0;
+    std::cout << "Agregado: " << instrucoesEscritas << " instrucoes em " << clock_cycle
+              << " ciclos  |  IPC: " << ipc_agregado << std::endl;
+
+    std::cout << "\n[ DISPUTA PELAS UNIDADES FUNCIONAIS ]" << std::endl;
+    std::cout << std::string(60, '-') << std::endl;
+    std::cout << std::left
+              << std::setw(12) << "Tipo"
+              << std::setw(10) << "Qtd"
+              << std::setw(16) << "Utilizacao"
+              << std::setw(22) << "Emissoes barradas" << std::endl;
+    std::cout << std::string(60, '-') << std::endl;
+
+    std::map<std::string, int> quantidades = config.unidades;
+    quantidades.insert(config.unidadesMem.begin(), config.unidadesMem.end());
+    for (const auto& pair : quantidades) {
+        auto ocupacao = ocupacaoPorTipo.find(pair.first);
+        auto bloqueios = bloqueiosPorTipo.find(pair.first);
+        double utilizacao = (pair.second > 0 && clock_cycle > 0 && ocupacao != ocupacaoPorTipo.end())
+                            ? 100.0 * ocupacao->second / (static_cast<double>(pair.second) * clock_cycle) : 0.0;
+        std::cout << std::left
+                  << std::setw(12) << pair.first
+                  << std::setw(10) << pair.second
+                  << std::setw(16) << (std::to_string(static_cast<int>(utilizacao + 0.5)) + " %")
+                  << std::setw(22) << (bloqueios != bloqueiosPorTipo.end() ? bloqueios->second : 0) << std::endl;
+    }
+    std::cout << std::string(60, '-') << std::endl;
+    std::cout << std::defaultfloat << std::setprecision(6);
+}
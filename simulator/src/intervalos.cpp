@@ -0,0 +1,123 @@
+#include "intervalos.hpp"
+#include "estado.hpp"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace {
+
+int maiorEscrita(const Estado& estado, int de, int ate) { // maior ciclo de escrita entre as instruções [de, ate) do estado
+    int maior = 0;
+    for (int i = de; i < ate; ++i) {
+        const auto& write = estado.estadoInstrucoes[i].write;
+        if (write.has_value()) {
+            maior = std::max(maior, write.value());
+        }
+    }
+    return maior;
+}
+
+void simulaUmIntervalo(const ConfigSimulador& config, const std::vector<InstrucaoInput>& instrucoes, ResultadoIntervalo& intervalo) {
+    std::vector<InstrucaoInput> trecho(instrucoes.begin() + intervalo.inicioAquecimento, instrucoes.begin() + intervalo.fim);
+    Estado estado(config, trecho);
+    intervalo.terminou = estado.executaAteTerminar(estado.limiteCiclosSeguro());
+
+    // as instruções de aquecimento só preparam o estado da máquina: o custo do intervalo é o
+    // tempo entre a última escrita do aquecimento e a última escrita das instruções medidas
+    int medidas_de = intervalo.inicio - intervalo.inicioAquecimento;
+    int fim_aquecimento = maiorEscrita(estado, 0, medidas_de);
+    int fim_intervalo = maiorEscrita(estado, medidas_de, static_cast<int>(trecho.size()));
+    intervalo.ciclos = std::max(0, fim_intervalo - fim_aquecimento);
+}
+
+}
+
+ResultadoIntervalos simulaIntervalos(const ConfigSimulador& config, const std::vector<InstrucaoInput>& instrucoes,
+                                     int num_intervalos, int aquecimento, bool com_referencia) {
+    ResultadoIntervalos resultado;
+    const int total = static_cast<int>(instrucoes.size());
+    if (total == 0) return resultado;
+
+    num_intervalos = std::max(1, std::min(num_intervalos, total));
+    aquecimento = std::max(0, aquecimento);
+
+    for (int k = 0; k < num_intervalos; ++k) {
+        ResultadoIntervalo intervalo;
+        intervalo.inicio = static_cast<int>(static_cast<long long>(total) * k / num_intervalos);
+        intervalo.fim = static_cast<int>(static_cast<long long>(total) * (k + 1) / num_intervalos);
+        intervalo.inicioAquecimento = std::max(0, intervalo.inicio - aquecimento);
+        resultado.intervalos.push_back(intervalo);
+    }
+
+    int num_threads = static_cast<int>(std::thread::hardware_concurrency());
+    resultado.threadsUsadas = std::max(1, std::min(num_threads, num_intervalos));
+
+    auto inicio_paralelo = std::chrono::steady_clock::now();
+    std::atomic<int> proximo{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < resultado.threadsUsadas; ++t) {
+        threads.emplace_back([&]() {
+            for (int k = proximo++; k < num_intervalos; k = proximo++) {
+                simulaUmIntervalo(config, instrucoes, resultado.intervalos[k]);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    resultado.segundosParalelo = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio_paralelo).count();
+
+    for (const auto& intervalo : resultado.intervalos) {
+        resultado.ciclosEstimados += intervalo.ciclos;
+    }
+
+    if (com_referencia) {
+        auto inicio_referencia = std::chrono::steady_clock::now();
+        Estado referencia(config, instrucoes);
+        if (referencia.executaAteTerminar(referencia.limiteCiclosSeguro())) {
+            resultado.ciclosReferencia = referencia.clock_cycle;
+        }
+        resultado.segundosReferencia = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio_referencia).count();
+    }
+
+    return resultado;
+}
+
+void imprimeResultadoIntervalos(const ResultadoIntervalos& resultado) { // relatório por intervalo, total estimado e erro
+    std::cout << "\n[ SIMULACAO POR INTERVALOS ]" << std::endl;
+    std::cout << std::string(70, '-') << std::endl;
+    std::cout << std::left
+              << std::setw(10) << "Intervalo"
+              << std::setw(16) << "Instrucoes"
+              << std::setw(16) << "Aquecimento"
+              << std::setw(10) << "Ciclos"
+              << std::setw(10) << "Status" << std::endl;
+    std::cout << std::string(70, '-') << std::endl;
+
+    for (size_t k = 0; k < resultado.intervalos.size(); ++k) {
+        const auto& intervalo = resultado.intervalos[k];
+        std::cout << std::left
+                  << std::setw(10) << k
+                  << std::setw(16) << (std::to_string(intervalo.inicio) + "-" + std::to_string(intervalo.fim - 1))
+                  << std::setw(16) << (intervalo.inicio - intervalo.inicioAquecimento)
+                  << std::setw(10) << intervalo.ciclos
+                  << std::setw(10) << (intervalo.terminou ? "[ OK ]" : "[LIMITE]") << std::endl;
+    }
+    std::cout << std::string(70, '-') << std::endl;
+
+    std::cout << "Threads: " << resultado.threadsUsadas
+              << "  |  Tempo paralelo: " << std::fixed << std::setprecision(3) << resultado.segundosParalelo << " s" << std::endl;
+    std::cout << "Ciclos estimados: " << resultado.ciclosEstimados << std::endl;
+
+    if (resultado.ciclosReferencia.has_value()) {
+        int referencia = resultado.ciclosReferencia.value();
+        double erro = referencia > 0 ? 100.0 * (resultado.ciclosEstimados - referencia) / referencia : 0.0;
+        std::cout << "Ciclos referencia (Estado sequencial): " << referencia
+                  << "  |  Tempo: " << resultado.segundosReferencia << " s" << std::endl;
+        std::cout << "Erro da estimativa: " << std::showpos << std::setprecision(2) << erro << std::noshowpos << " %" << std::endl;
+    }
+    std::cout << std::defaultfloat << std::setprecision(6);
+}
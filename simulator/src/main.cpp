@@ -1,13 +1,123 @@
 #include "parser.hpp"
 #include "estado.hpp"
+#include "intervalos.hpp"
+#include "diferencial.hpp"
+#include "analise.hpp"
+#include "estado_smt.hpp"
+#include "regime.hpp"
+#include "ajuste.hpp"
+#include "utils.hpp"
 #include <iostream>
 #include <string>
+#include <climits>
+#include <cctype>
+
+namespace {
+
+void imprimeUso(const char* programa) {
+    std::cerr << "Usage: " << programa << " <input_file.txt> [run | analyze | steady [ref] | tune [generations] [population] [seed] | intervals <K> [warmup] [ref]]" << std::endl;
+    std::cerr << "       " << programa << " diff [simulador | smt | regime | all] [cases] [seed] [output_file.txt]" << std::endl;
+    std::cerr << "       " << programa << " smt <rr|icount> <trace1.txt> <trace2.txt> ..." << std::endl;
+}
+
+bool argumentoInteiro(int argc, char* argv[], int indice, long long minimo, long long maximo, long long& saida) { // argumento opcional: mantém 'saida' se ausente
+    if (indice >= argc) return true;
+    if (parseInteiro(argv[indice], minimo, maximo, saida)) return true;
+    std::cerr << "Error: Invalid argument '" << argv[indice] << "' (expected an integer in [" << minimo << ", " << maximo << "])" << std::endl;
+    return false;
+}
+
+}
 
 int main(int argc, char* argv[]) { //leitura do arquivo principal, criação do simulador, decisão de execução do algoritmo e executa todas as instruções
     if (argc < 2) {
-        std::cerr << "Usage: " << argv[0] << " <input_file.txt>" << std::endl;
+        imprimeUso(argv[0]);
         return 1;
     }
+
+    if (std::string(argv[1]) == "smt") { // vários traços compartilhando as unidades funcionais; a configuração vem do primeiro e os demais devem repeti-la ou omiti-la
+        PoliticaEmissao politica;
+        if (argc < 4 || !parsePoliticaEmissao(argv[2], politica)) {
+            std::cerr << "Usage: " << argv[0] << " smt <rr|icount> <trace1.txt> <trace2.txt> ..." << std::endl;
+            return 1;
+        }
+        ConfigSimulador config;
+        std::vector<std::vector<InstrucaoInput>> tracos;
+        for (int i = 3; i < argc; ++i) {
+            ConfigSimulador config_traco;
+            std::vector<InstrucaoInput> traco;
+            if (!parseInputFile(argv[i], config_traco, traco)) {
+                return 1;
+            }
+            if (i == 3) {
+                config = config_traco;
+            } else if (!semConfigMaquina(config_traco) && !mesmaMaquina(config, config_traco)) {
+                std::cerr << "Error: " << argv[i] << " describes a different machine than " << argv[3]
+                          << " (all SMT traces share one config; leave CONFIG empty to inherit it)" << std::endl;
+                return 1;
+            }
+            tracos.push_back(traco);
+        }
+
+        EstadoSMT simulador(config, tracos, politica);
+        if (!simulador.executaAteTerminar(simulador.limiteCiclosSeguro())) {
+            std::cout << "\n== Simulacao Parada: Limite de ciclos (" << simulador.clock_cycle << ") atingido. ==" << std::endl;
+        }
+        simulador.imprimeRelatorioSMT();
+        return 0;
+    }
+
+    if (std::string(argv[1]) == "diff") { // verificação diferencial ciclo a ciclo entre motores em traços aleatórios
+        // o Estado é a referência; novos motores entram aqui como candidatos
+        struct Candidato {
+            std::string nome;
+            ComparadorMotores compara;
+            GeradorCasos gera;
+        };
+        const std::vector<Candidato> candidatos = {
+            {"simulador", comparaEmLockstep<Estado, Simulador<ObservadorNulo>>, geraCasoAleatorio},
+            {"smt", comparaEmLockstep<Estado, EstadoSMTUmaThread>, geraCasoAleatorio},
+            {"regime", comparaRegimeComCompleto, geraCasoLaco}, // extrapolação contra a simulação completa, em laços
+        };
+        int primeiro_argumento = 2;
+        std::string escolhido = "all";
+        if (argc > 2 && !std::isdigit(static_cast<unsigned char>(argv[2][0])) && argv[2][0] != '-') {
+            escolhido = argv[2];
+            primeiro_argumento = 3;
+        }
+        long long num_casos = 1000, semente = 1;
+        if (!argumentoInteiro(argc, argv, primeiro_argumento, 1, INT_MAX, num_casos) ||
+            !argumentoInteiro(argc, argv, primeiro_argumento + 1, 0, UINT_MAX, semente)) {
+            imprimeUso(argv[0]);
+            return 1;
+        }
+        std::string saida = argc > primeiro_argumento + 2 ? argv[primeiro_argumento + 2] : "input_minimo.txt";
+
+        bool algum = false;
+        for (const auto& candidato : candidatos) {
+            if (escolhido != "all" && escolhido != candidato.nome) continue;
+            algum = true;
+            ResultadoDiferencial resultado = executaVerificacaoDiferencial(static_cast<int>(num_casos), static_cast<unsigned>(semente),
+                                                                           24, candidato.compara, candidato.gera);
+            if (!resultado.casoMinimo.has_value()) {
+                std::cout << "== Verificacao diferencial (" << candidato.nome << "): " << resultado.casosExecutados
+                          << " casos sem divergencia. ==" << std::endl;
+                continue;
+            }
+            std::cout << "== Divergencia (" << candidato.nome << ") no caso " << resultado.casosExecutados
+                      << " (ciclo " << resultado.divergencia->ciclo << "): " << resultado.divergencia->descricao << " ==" << std::endl;
+            if (writeInputFile(saida, resultado.casoMinimo->config, resultado.casoMinimo->instrucoes)) {
+                std::cout << "Caso minimo (" << resultado.casoMinimo->instrucoes.size() << " instrucoes) salvo em " << saida << std::endl;
+            }
+            return 1;
+        }
+        if (!algum) {
+            std::cerr << "Error: Unknown engine '" << escolhido << "'" << std::endl;
+            imprimeUso(argv[0]);
+            return 1;
+        }
+        return 0;
+    }
     std::string filename = argv[1];
 
     ConfigSimulador config;
@@ -22,9 +132,66 @@ int main(int argc, char* argv[]) { //leitura do arquivo principal, criação do
         return 0;
     }
 
+    if (argc > 2 && std::string(argv[2]) == "intervals") { // simulação paralela do traço dividido em K intervalos
+        long long num_intervalos = 4, aquecimento = 0;
+        if (!argumentoInteiro(argc, argv, 3, 1, INT_MAX, num_intervalos) || !argumentoInteiro(argc, argv, 4, 0, INT_MAX, aquecimento)) {
+            imprimeUso(argv[0]);
+            return 1;
+        }
+        bool com_referencia = argc > 5 && std::string(argv[5]) == "ref";
+        imprimeResultadoIntervalos(simulaIntervalos(config, instructions, static_cast<int>(num_intervalos),
+                                                    static_cast<int>(aquecimento), com_referencia));
+        return 0;
+    }
+
+    if (argc > 2 && std::string(argv[2]) == "analyze") { // limites do fluxo de dados e de recursos ao lado dos ciclos simulados
+        Estado simulador(config, instructions);
+        ResultadoAnalise analise = analisaTraco(simulador);
+        if (!simulador.executaAteTerminar(simulador.limiteCiclosSeguro())) {
+            std::cout << "\n== Simulacao Parada: Limite de ciclos (" << simulador.clock_cycle << ") atingido. ==" << std::endl;
+        }
+        imprimeAnalise(analise, simulador.clock_cycle);
+        return 0;
+    }
+
+    if (argc > 2 && std::string(argv[2]) == "tune") { // busca de UNITS/MEM_UNITS sob o orçamento (COST/BUDGET)
+        ParametrosAjuste parametros;
+        long long geracoes = parametros.geracoes, populacao = parametros.populacao, semente = parametros.semente;
+        if (!argumentoInteiro(argc, argv, 3, 1, INT_MAX, geracoes) || !argumentoInteiro(argc, argv, 4, 2, INT_MAX, populacao) ||
+            !argumentoInteiro(argc, argv, 5, 0, UINT_MAX, semente)) {
+            imprimeUso(argv[0]);
+            return 1;
+        }
+        parametros.geracoes = static_cast<int>(geracoes);
+        parametros.populacao = static_cast<int>(populacao);
+        parametros.semente = static_cast<unsigned>(semente);
+        imprimeResultadoAjuste(ajustaUnidades(config, instructions, parametros));
+        return 0;
+    }
+
+    if (argc > 2 && std::string(argv[2]) == "steady") { // simula até o laço entrar em regime e extrapola as iterações restantes
+        Estado simulador(config, instructions);
+        ResultadoRegime regime = executaComExtrapolacao(simulador, simulador.limiteCiclosSeguro());
+        imprimeResultadoRegime(regime, simulador);
+        if (argc > 3 && std::string(argv[3]) == "ref") { // confere contra a simulação completa
+            Estado referencia(config, instructions);
+            referencia.executaAteTerminar(referencia.limiteCiclosSeguro());
+            int divergencias = 0;
+            for (size_t i = 0; i < referencia.estadoInstrucoes.size(); ++i) {
+                const EstadoInstrucao& a = referencia.estadoInstrucoes[i];
+                const EstadoInstrucao& b = simulador.estadoInstrucoes[i];
+                if (a.issue != b.issue || a.exeCompleta != b.exeCompleta || a.write != b.write) divergencias++;
+            }
+            if (referencia.estacaoRegistradores != simulador.estacaoRegistradores) divergencias++;
+            if (referencia.conflitosCDB != simulador.conflitosCDB) divergencias++;
+            std::cout << "Referencia: " << referencia.clock_cycle << " ciclos  |  Divergencias: " << divergencias << std::endl;
+        }
+        return 0;
+    }
+
     Estado simulador(config, instructions);
     bool terminou = false;
-    int cycle_limit = 200;
+    int cycle_limit = simulador.limiteCiclosSeguro();
     int current_cycle = 0;
 
     std::cout << "Simulacao Iniciada. Pressione Enter para avancar ciclo a ciclo, ou 'r' para rodar ate o fim." << std::endl;
@@ -56,6 +223,10 @@ int main(int argc, char* argv[]) { //leitura do arquivo principal, criação do
         }
     }
 
+    if (simulador.config.barramentosCDB > 0) {
+        std::cout << "Conflitos de CDB (escritas adiadas): " << simulador.conflitosCDB << std::endl;
+    }
+
     if (!terminou && current_cycle >= cycle_limit) {
         std::cout << "\n== Simulacao Parada: Limite de ciclos (" << cycle_limit << ") atingido. ==" << std::endl;
     }
@@ -10,10 +10,14 @@ bool parseInputFile(const std::string& filename, ConfigSimulador& out_config, st
         std::cerr << "Error: Could not open file " << filename << std::endl;
         return false;
     }
+    return parseInput(infile, out_config, out_instructions);
+}
 
+bool parseInput(std::istream& infile, ConfigSimulador& out_config, std::vector<InstrucaoInput>& out_instructions) { // leitura de qualquer fluxo no formato do arquivo de entrada
     std::string line;
     enum class ParseState { NONE, CONFIG, INSTRUCTIONS };
     ParseState currentState = ParseState::NONE;
+    std::string linhaPrioridadeCDB; // validada no fim: UNITS/MEM_UNITS podem vir depois de CDB_PRIORITY
 
     while (std::getline(infile, line)) {
         line = trim(line);
@@ -50,6 +54,36 @@ bool parseInputFile(const std::string& filename, ConfigSimulador& out_config, st
             } else if (keyword == "MEM_UNITS") {
                 ss >> param1 >> param2_val;
                 out_config.unidadesMem[param1] = param2_val;
+            } else if (keyword == "VUNITS" || keyword == "VCYCLES") {
+                ss >> param1 >> param2_val;
+                if (param1 != "VAdd" && param1 != "VMult" && param1 != "VLoad" && param1 != "VStore") {
+                    std::cerr << "Warning: Unknown vector unit type '" << param1 << "' in line: " << line << std::endl;
+                } else if (keyword == "VUNITS") {
+                    out_config.unidades[param1] = param2_val;
+                } else {
+                    out_config.ciclos[param1] = param2_val;
+                }
+            } else if (keyword == "VLEN") {
+                ss >> param2_val;
+                out_config.comprimentoVetorMaximo = param2_val;
+            } else if (keyword == "CHAINING") {
+                ss >> param2_val;
+                out_config.encadeamento = param2_val != 0;
+            } else if (keyword == "COST") {
+                ss >> param1 >> param2_val;
+                out_config.custos[param1] = param2_val;
+            } else if (keyword == "BUDGET") {
+                ss >> param2_val;
+                out_config.orcamento = param2_val;
+            } else if (keyword == "CDB") {
+                ss >> param2_val;
+                out_config.barramentosCDB = param2_val;
+            } else if (keyword == "CDB_PRIORITY") {
+                out_config.prioridadeCDB.clear();
+                linhaPrioridadeCDB = line;
+                while (ss >> param1) {
+                    out_config.prioridadeCDB.push_back(param1);
+                }
             } else {
                 std::cerr << "Warning: Unknown config keyword '" << keyword << "' in line: " << line << std::endl;
             }
@@ -63,6 +97,69 @@ bool parseInputFile(const std::string& filename, ConfigSimulador& out_config, st
             }
         }
     }
+    if (!out_config.unidades.empty() || !out_config.unidadesMem.empty()) { // sem unidades declaradas (traço SMT que herda a máquina), não há contra o que validar
+        std::vector<std::string> prioridade;
+        for (const auto& tipo : out_config.prioridadeCDB) {
+            if (out_config.unidades.count(tipo) || out_config.unidadesMem.count(tipo)) {
+                prioridade.push_back(tipo);
+            } else {
+                std::cerr << "Warning: Unknown CDB_PRIORITY unit type '" << tipo << "' in line: " << linhaPrioridadeCDB << std::endl;
+            }
+        }
+        out_config.prioridadeCDB = prioridade;
+    }
     out_config.numInstrucoes = out_instructions.size();
     return true;
-}
\ No newline at end of file
+}
+
+bool writeInputFile(const std::string& filename, const ConfigSimulador& config, const std::vector<InstrucaoInput>& instructions) { // escrita no mesmo formato lido por parseInputFile
+    std::ofstream outfile(filename);
+    if (!outfile.is_open()) {
+        std::cerr << "Error: Could not write file " << filename << std::endl;
+        return false;
+    }
+
+    outfile << "CONFIG_BEGIN\n";
+    bool tem_vetorial = false;
+    for (const auto& pair : config.ciclos) {
+        bool vetorial = pair.first[0] == 'V';
+        tem_vetorial = tem_vetorial || vetorial;
+        outfile << (vetorial ? "VCYCLES " : "CYCLES ") << pair.first << " " << pair.second << "\n";
+    }
+    for (const auto& pair : config.unidades) {
+        outfile << (pair.first[0] == 'V' ? "VUNITS " : "UNITS ") << pair.first << " " << pair.second << "\n";
+    }
+    for (const auto& pair : config.unidadesMem) {
+        outfile << "MEM_UNITS " << pair.first << " " << pair.second << "\n";
+    }
+    if (tem_vetorial) {
+        outfile << "VLEN " << config.comprimentoVetorMaximo << "\n";
+        outfile << "CHAINING " << (config.encadeamento ? 1 : 0) << "\n";
+    }
+    for (const auto& pair : config.custos) {
+        outfile << "COST " << pair.first << " " << pair.second << "\n";
+    }
+    if (config.orcamento > 0) {
+        outfile << "BUDGET " << config.orcamento << "\n";
+    }
+    if (config.barramentosCDB > 0) {
+        outfile << "CDB " << config.barramentosCDB << "\n";
+    }
+    if (!config.prioridadeCDB.empty()) {
+        outfile << "CDB_PRIORITY";
+        for (const auto& tipo : config.prioridadeCDB) outfile << " " << tipo;
+        outfile << "\n";
+    }
+    outfile << "CONFIG_END\n\n";
+
+    outfile << "INSTRUCTIONS_BEGIN\n";
+    for (const auto& instr : instructions) {
+        outfile << instr.d_operacao;
+        for (const std::string* campo : {&instr.r_reg, &instr.s_reg_or_imm, &instr.t_reg_or_label}) {
+            if (!campo->empty()) outfile << " " << *campo;
+        }
+        outfile << "\n";
+    }
+    outfile << "INSTRUCTIONS_END\n";
+    return true;
+}
@@ -0,0 +1,163 @@
+#include "perfil.hpp"
+
+#ifdef TOMASULO_PERFIL
+
+#include <array>
+#include <iostream>
+#include <iomanip>
+#include <mutex>
+
+namespace {
+
+const char* const nomesEstagios[] = {"issueNovaInstrucao", "executaInstrucao", "escreveInstrucao",
+                                     "liberaUFEsperandoResultado", "executa_ciclo"};
+constexpr int numEstagios = static_cast<int>(EstagioPerfil::Total);
+
+// histograma logarítmico: 64 potências de dois com 16 subdivisões cada (erro < 6,25% nos percentis)
+// mantém a memória constante mesmo em execuções de centenas de milhões de ciclos
+constexpr int subdivisoes = 16;
+constexpr int numFaixas = 64 * subdivisoes;
+
+int faixaDe(std::uint64_t ticks) {
+    if (ticks < subdivisoes) return static_cast<int>(ticks);
+    int expoente = 63 - __builtin_clzll(ticks);
+    int sub = static_cast<int>((ticks >> (expoente - 4)) & (subdivisoes - 1));
+    return (expoente - 3) * subdivisoes + sub;
+}
+
+std::uint64_t limiteInferiorFaixa(int faixa) {
+    if (faixa < subdivisoes) return faixa;
+    int expoente = faixa / subdivisoes + 3;
+    int sub = faixa % subdivisoes;
+    return (static_cast<std::uint64_t>(subdivisoes + sub)) << (expoente - 4);
+}
+
+struct EstatisticaEstagio { // tempos em ticks de leRelogioPerfil; a conversão para ns fica para o relatório
+    std::array<std::uint64_t, numFaixas> histograma{};
+    std::uint64_t chamadas = 0;
+    std::uint64_t totalTicks = 0;
+    std::uint64_t maximoTicks = 0;
+
+    void adicionaAmostra(std::uint64_t ticks) {
+        histograma[faixaDe(ticks)]++;
+        totalTicks += ticks;
+        if (ticks > maximoTicks) maximoTicks = ticks;
+    }
+
+    void soma(const EstatisticaEstagio& outra) {
+        for (int i = 0; i < numFaixas; ++i) histograma[i] += outra.histograma[i];
+        chamadas += outra.chamadas;
+        totalTicks += outra.totalTicks;
+        if (outra.maximoTicks > maximoTicks) maximoTicks = outra.maximoTicks;
+    }
+
+    std::uint64_t percentil(double p, std::uint64_t amostras) const {
+        std::uint64_t alvo = static_cast<std::uint64_t>(p * amostras);
+        std::uint64_t acumulado = 0;
+        for (int i = 0; i < numFaixas; ++i) {
+            acumulado += histograma[i];
+            if (acumulado > alvo) return limiteInferiorFaixa(i);
+        }
+        return maximoTicks;
+    }
+};
+
+struct Perfil {
+    std::array<EstatisticaEstagio, numEstagios> estagios{};
+    std::uint64_t ciclos = 0;
+};
+
+class PerfilGlobal { // junta os perfis de todas as threads e imprime o relatório na saída do programa
+public:
+    PerfilGlobal() : ticksInicio(leRelogioPerfil()), relogioInicio(std::chrono::steady_clock::now()) {}
+
+    void junta(const Perfil& perfil) {
+        std::lock_guard<std::mutex> trava(mutex);
+        for (int e = 0; e < numEstagios; ++e) total.estagios[e].soma(perfil.estagios[e]);
+        total.ciclos += perfil.ciclos;
+    }
+
+    ~PerfilGlobal() {
+        if (total.ciclos == 0) return;
+        // ns por tick medidos ao longo de toda a execução (1 quando o relógio já é steady_clock)
+        const double ns_relogio = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - relogioInicio).count();
+        const std::uint64_t ticks = leRelogioPerfil() - ticksInicio;
+        const double ns_por_tick = ticks > 0 ? ns_relogio / ticks : 1.0;
+        auto ns = [&](std::uint64_t t) { return static_cast<std::uint64_t>(t * ns_por_tick + 0.5); };
+        std::cerr << "\n[ PERFIL DOS ESTAGIOS (ns por ciclo simulado) ]" << std::endl;
+        std::cerr << std::string(110, '-') << std::endl;
+        std::cerr << std::left
+                  << std::setw(30) << "Estagio"
+                  << std::setw(14) << "Chamadas"
+                  << std::setw(12) << "Media"
+                  << std::setw(10) << "p50"
+                  << std::setw(10) << "p90"
+                  << std::setw(10) << "p99"
+                  << std::setw(12) << "Max"
+                  << std::setw(12) << "Total (ms)" << std::endl;
+        std::cerr << std::string(110, '-') << std::endl;
+        for (int e = 0; e < numEstagios; ++e) {
+            const EstatisticaEstagio& estagio = total.estagios[e];
+            std::cerr << std::left
+                      << std::setw(30) << nomesEstagios[e]
+                      << std::setw(14) << estagio.chamadas
+                      << std::setw(12) << std::fixed << std::setprecision(1) << estagio.totalTicks * ns_por_tick / total.ciclos
+                      << std::setw(10) << ns(estagio.percentil(0.50, total.ciclos))
+                      << std::setw(10) << ns(estagio.percentil(0.90, total.ciclos))
+                      << std::setw(10) << ns(estagio.percentil(0.99, total.ciclos))
+                      << std::setw(12) << ns(estagio.maximoTicks)
+                      << std::setw(12) << std::setprecision(3) << estagio.totalTicks * ns_por_tick / 1e6 << std::endl;
+        }
+        std::cerr << std::string(110, '-') << std::endl;
+        std::cerr << "Ciclos simulados: " << total.ciclos
+                  << "  |  liberaUFEsperandoResultado ja esta incluido em escreveInstrucao" << std::endl;
+    }
+
+private:
+    std::mutex mutex;
+    Perfil total;
+    std::uint64_t ticksInicio;
+    std::chrono::steady_clock::time_point relogioInicio;
+};
+
+PerfilGlobal perfilGlobal;
+
+struct PerfilThread { // acumuladores da thread; ao terminar a thread, são somados ao perfil global
+    Perfil perfil;
+    std::array<std::uint64_t, numEstagios> cicloAtual{};
+
+    ~PerfilThread() { perfilGlobal.junta(perfil); }
+};
+
+// um thread_local com destrutor passa por uma função de inicialização a cada acesso; o ponteiro
+// trivial abaixo é lido direto, e o objeto dono só é tocado na primeira medição da thread
+thread_local PerfilThread* perfilAtual = nullptr;
+
+PerfilThread& perfilDaThread() {
+    if (!perfilAtual) {
+        static thread_local PerfilThread dono;
+        perfilAtual = &dono;
+    }
+    return *perfilAtual;
+}
+
+}
+
+void registraTempoEstagio(EstagioPerfil estagio, std::uint64_t ticks) { // acumula no ciclo corrente da thread
+    PerfilThread& perfil_thread = perfilDaThread();
+    int e = static_cast<int>(estagio);
+    perfil_thread.cicloAtual[e] += ticks;
+    perfil_thread.perfil.estagios[e].chamadas++;
+}
+
+void fechaCicloPerfil(const std::uint64_t (&tempos_ciclo)[numEstagios]) { // encerra o ciclo corrente: uma amostra por estágio
+    PerfilThread& perfil_thread = perfilDaThread();
+    for (int e = 0; e < numEstagios; ++e) {
+        if (e != static_cast<int>(EstagioPerfil::Liberacao)) perfil_thread.perfil.estagios[e].chamadas++;
+        perfil_thread.perfil.estagios[e].adicionaAmostra(perfil_thread.cicloAtual[e] + tempos_ciclo[e]);
+        perfil_thread.cicloAtual[e] = 0;
+    }
+    perfil_thread.perfil.ciclos++;
+}
+
+#endif
@@ -0,0 +1,262 @@
+#include "regime.hpp"
+#include <iostream>
+#include <algorithm>
+#include <sstream>
+#include <unordered_map>
+
+namespace {
+
+bool mesmaInstrucao(const InstrucaoDetalhes& a, const InstrucaoDetalhes& b) {
+    return a.operacao == b.operacao && a.registradorR == b.registradorR &&
+           a.registradorS == b.registradorS && a.registradorT == b.registradorT;
+}
+
+bool ehDesvio(const InstrucaoDetalhes& instr) {
+    return instr.operacao == "BNEZ" || instr.operacao == "BEQ";
+}
+
+struct FronteirasLaco {
+    int periodo = 0;               // instruções por iteração
+    std::vector<int> fronteiras;   // primeira instrução de cada iteração do trecho periódico
+};
+
+FronteirasLaco detectaLaco(const std::vector<EstadoInstrucao>& instrucoes) { // corpo delimitado pelos dois últimos desvios
+    FronteirasLaco laco;
+    const int n = static_cast<int>(instrucoes.size());
+    std::vector<int> desvios;
+    for (int i = 0; i < n; ++i) {
+        if (ehDesvio(instrucoes[i].instrucao)) desvios.push_back(i);
+    }
+    if (desvios.size() < 3) return laco;
+
+    const int periodo = desvios.back() - desvios[desvios.size() - 2];
+    // menor início a partir do qual o traço se repete com este período até o fim
+    int inicio = n - periodo;
+    while (inicio > 0 && mesmaInstrucao(instrucoes[inicio - 1].instrucao, instrucoes[inicio - 1 + periodo].instrucao)) {
+        inicio--;
+    }
+
+    for (int b = desvios.back() + 1; b >= inicio; b -= periodo) {
+        if (b < n) laco.fronteiras.push_back(b);
+    }
+    std::reverse(laco.fronteiras.begin(), laco.fronteiras.end());
+    if (laco.fronteiras.size() >= 3) laco.periodo = periodo;
+    return laco;
+}
+
+std::string relativo(const std::optional<std::string>& valor) {
+    return valor.has_value() ? valor.value() : "-";
+}
+
+std::string assinaturaEstado(const Estado& estado, int base) { // estado normalizado em relação à iteração que começa em 'base'
+    std::ostringstream ss;
+    auto instrucao_relativa = [&](const EstadoInstrucao* instr) {
+        if (!instr) return;
+        const InstrucaoDetalhes& d = instr->instrucao;
+        ss << (instr->posicao - base) << ':' << d.operacao << ',' << d.registradorR << ',' << d.registradorS << ','
+           << d.registradorT << ',' << (instr->exeCompleta.has_value() ? estado.clock_cycle - instr->exeCompleta.value() : -1)
+           << (instr->busy ? "b" : "");
+    };
+
+    for (const auto& pair : estado.unidadesFuncionais) {
+        const UnidadeFuncional& uf = pair.second;
+        if (!uf.ocupado) continue;
+        ss << '[' << uf.nome << ' ' << uf.tempo.value_or(0) << ' ';
+        instrucao_relativa(uf.estadoInstrucaoOriginal);
+        // valores prontos (registrador, VAL(...), CHAIN(...)) são equivalentes para o futuro: só importa se há tag
+        ss << ' ' << uf.vj.has_value() << uf.vk.has_value() << ' ' << relativo(uf.qj) << ' ' << relativo(uf.qk)
+           << ' ' << uf.comprimentoVetor.value_or(0) << ']';
+    }
+    for (const auto& pair : estado.unidadesFuncionaisMemoria) {
+        const UnidadeFuncionalMemoria& uf = pair.second;
+        if (!uf.ocupado) continue;
+        ss << '[' << uf.nome << ' ' << uf.tempo.value_or(0) << ' ';
+        instrucao_relativa(uf.estadoInstrucaoOriginal);
+        ss << ' ' << relativo(uf.qi) << ' ' << relativo(uf.qj) << ']';
+    }
+
+    ss << '|';
+    for (const auto& pair : estado.estacaoRegistradores) { // só tags de estações: VAL(...) e vazio são o mesmo valor pronto
+        const auto& tag = pair.second;
+        if (tag.has_value() && tag.value().rfind("VAL(", 0) != 0) {
+            ss << pair.first << '=' << tag.value() << ';';
+        }
+    }
+    ss << '|';
+    for (int comprimento : estado.registradorComprimentoVetor) {
+        ss << comprimento << ';';
+    }
+    return ss.str();
+}
+
+struct Fronteira { // estado registrado ao emitir a primeira instrução de uma iteração
+    int iteracao;
+    int ciclo;
+};
+
+}
+
+ResultadoRegime executaComExtrapolacao(Estado& estado, int limite_ciclos) { // simula até o regime e extrapola o restante
+    ResultadoRegime resultado;
+    auto& instrucoes = estado.estadoInstrucoes;
+    const int n = static_cast<int>(instrucoes.size());
+
+    bool monothread = std::all_of(instrucoes.begin(), instrucoes.end(), [](const EstadoInstrucao& i) { return i.thread == 0; });
+    // com prioridade por tipo no CDB, uma instrução mais nova pode atrasar a escrita de uma mais antiga,
+    // então o tempo de uma iteração passa a depender das seguintes e a última não repete as anteriores
+    bool arbitragem_por_tipo = estado.config.barramentosCDB > 0 && !estado.config.prioridadeCDB.empty();
+    FronteirasLaco laco = monothread && !arbitragem_por_tipo ? detectaLaco(instrucoes) : FronteirasLaco();
+    resultado.lacoDetectado = laco.periodo > 0;
+    resultado.instrucoesPorIteracao = laco.periodo;
+
+    std::vector<std::string> unidadeDaInstrucao(n); // unidade usada por cada instrução (para a tabela final de registradores)
+    auto registra_emissoes = [&]() {
+        for (const auto& pair : estado.unidadesFuncionais) {
+            const EstadoInstrucao* instr = pair.second.estadoInstrucaoOriginal;
+            if (instr && instr->issue == estado.clock_cycle) unidadeDaInstrucao[instr->posicao] = pair.second.nome;
+        }
+        for (const auto& pair : estado.unidadesFuncionaisMemoria) {
+            const EstadoInstrucao* instr = pair.second.estadoInstrucaoOriginal;
+            if (instr && instr->issue == estado.clock_cycle) unidadeDaInstrucao[instr->posicao] = pair.second.nome;
+        }
+    };
+
+    std::unordered_map<std::string, Fronteira> vistos;
+    size_t proxima_fronteira = 0;
+    int base_repetida = -1, deslocamento_instr = 0, deslocamento_ciclos = 0;
+    bool terminou = estado.verificaSeJaTerminou();
+
+    while (!terminou && base_repetida < 0 && estado.clock_cycle < limite_ciclos) {
+        terminou = estado.executa_ciclo();
+        registra_emissoes();
+
+        if (proxima_fronteira >= laco.fronteiras.size()) continue;
+        const int base = laco.fronteiras[proxima_fronteira];
+        if (instrucoes[base].issue != estado.clock_cycle) continue;
+
+        std::string assinatura = assinaturaEstado(estado, base);
+        auto it = vistos.find(assinatura);
+        if (it != vistos.end()) {
+            resultado.iteracaoInicial = it->second.iteracao;
+            resultado.iteracaoRepetida = static_cast<int>(proxima_fronteira);
+            deslocamento_instr = base - laco.fronteiras[it->second.iteracao];
+            deslocamento_ciclos = estado.clock_cycle - it->second.ciclo;
+            base_repetida = base;
+        } else {
+            vistos.emplace(std::move(assinatura), Fronteira{static_cast<int>(proxima_fronteira), estado.clock_cycle});
+        }
+        proxima_fronteira++;
+    }
+
+    // as instruções anteriores à fronteira repetida são simuladas até o fim: servem de fonte para a extrapolação
+    int pendente = 0;
+    while (base_repetida >= 0 && !terminou && estado.clock_cycle < limite_ciclos) {
+        while (pendente < base_repetida && instrucoes[pendente].write.has_value()) pendente++;
+        if (pendente == base_repetida) break;
+        terminou = estado.executa_ciclo();
+        registra_emissoes();
+    }
+
+    // regime periódico: cada instrução repete a de um período antes, deslocada de deslocamento_ciclos
+    std::vector<EstadoInstrucao> extrapoladas;
+    bool consistente = base_repetida >= 0 && !terminou && pendente == base_repetida;
+    auto desloca = [&](const std::optional<int>& ciclo) -> std::optional<int> {
+        return ciclo.has_value() ? std::optional<int>(ciclo.value() + deslocamento_ciclos) : std::nullopt;
+    };
+    for (int i = base_repetida; consistente && i < n; ++i) {
+        const EstadoInstrucao& fonte = i - deslocamento_instr < base_repetida
+                                       ? instrucoes[i - deslocamento_instr]
+                                       : extrapoladas[i - deslocamento_instr - base_repetida];
+        EstadoInstrucao instr = instrucoes[i];
+        std::optional<int> issue = desloca(fonte.issue), exe = desloca(fonte.exeCompleta), write = desloca(fonte.write);
+        // o que já foi simulado além da fronteira precisa coincidir com a previsão
+        if ((instr.issue.has_value() && instr.issue != issue) ||
+            (instr.exeCompleta.has_value() && instr.exeCompleta != exe) ||
+            (instr.write.has_value() && instr.write != write) ||
+            (!unidadeDaInstrucao[i].empty() && unidadeDaInstrucao[i] != unidadeDaInstrucao[i - deslocamento_instr])) {
+            consistente = false;
+            break;
+        }
+        instr.issue = issue;
+        instr.exeCompleta = exe;
+        instr.write = write;
+        instr.busy = false;
+        unidadeDaInstrucao[i] = unidadeDaInstrucao[i - deslocamento_instr];
+        extrapoladas.push_back(std::move(instr));
+    }
+
+    if (!consistente) {
+        while (!terminou && estado.clock_cycle < limite_ciclos) {
+            terminou = estado.executa_ciclo();
+        }
+        resultado.ciclosSimulados = estado.clock_cycle;
+        return resultado;
+    }
+
+    resultado.ciclosSimulados = estado.clock_cycle;
+    int ultimo_ciclo = estado.clock_cycle;
+    for (int i = base_repetida; i < n; ++i) {
+        EstadoInstrucao& instr = instrucoes[i];
+        if (!instr.write.has_value()) resultado.instrucoesExtrapoladas++;
+        instr = std::move(extrapoladas[i - base_repetida]);
+        ultimo_ciclo = std::max(ultimo_ciclo, instr.write.value_or(0));
+    }
+
+    // máquina vazia ao final, com a tabela de registradores apontando para o último produtor de cada um
+    for (auto& pair : estado.unidadesFuncionais) estado.desalocaUF(pair.second);
+    for (auto& pair : estado.unidadesFuncionaisMemoria) estado.desalocaUFMem(pair.second);
+    for (int i = base_repetida; i < n; ++i) {
+        const InstrucaoDetalhes& d = instrucoes[i].instrucao;
+        if (d.operacao == "SETVL") {
+            estado.defineComprimentoVetor(instrucoes[i]);
+            continue;
+        }
+        std::optional<std::string> destino = Estado::registradorDestino(d);
+        if (destino.has_value() && estado.estacaoRegistradores.count(destino.value())) {
+            estado.estacaoRegistradores[destino.value()] = "VAL(" + unidadeDaInstrucao[i] + ")";
+        }
+    }
+    // cada ciclo em que uma instrução pronta perde o CDB é um conflito: o total é a soma das esperas,
+    // o que inclui as iterações extrapoladas sem precisar simulá-las
+    if (estado.config.barramentosCDB > 0) {
+        estado.conflitosCDB = 0;
+        for (const EstadoInstrucao& instr : instrucoes) {
+            if (instr.write.has_value() && instr.exeCompleta.has_value()) {
+                estado.conflitosCDB += instr.write.value() - instr.exeCompleta.value() - 1;
+            }
+        }
+    }
+    estado.clock_cycle = ultimo_ciclo;
+    estado.proximaEmissao = instrucoes.size();
+    estado.instrucoesEscritas = instrucoes.size();
+
+    resultado.extrapolou = true;
+    resultado.ciclosPorPeriodo = deslocamento_ciclos;
+    resultado.instrucoesPorPeriodo = deslocamento_instr;
+    return resultado;
+}
+
+void imprimeResultadoRegime(const ResultadoRegime& resultado, const Estado& estado) {
+    std::cout << "\n[ REGIME PERMANENTE ]" << std::endl;
+    std::cout << std::string(70, '-') << std::endl;
+    if (estado.config.barramentosCDB > 0 && !estado.config.prioridadeCDB.empty()) {
+        std::cout << "Extrapolacao desativada: com CDB_PRIORITY a ultima iteracao nao repete as anteriores." << std::endl;
+    } else if (!resultado.lacoDetectado) {
+        std::cout << "Nenhum laco detectado (sao necessarias 3 iteracoes iguais terminadas em desvio)." << std::endl;
+    } else if (!resultado.extrapolou) {
+        std::cout << "Laco de " << resultado.instrucoesPorIteracao << " instrucoes, mas o estado nao se repetiu: simulacao completa." << std::endl;
+    } else {
+        std::cout << "Laco de " << resultado.instrucoesPorIteracao << " instrucoes por iteracao" << std::endl;
+        std::cout << "Estado da iteracao " << resultado.iteracaoInicial << " repetido na iteracao " << resultado.iteracaoRepetida
+                  << ": periodo de " << resultado.instrucoesPorPeriodo << " instrucoes em "
+                  << resultado.ciclosPorPeriodo << " ciclos" << std::endl;
+        std::cout << "Ciclos simulados: " << resultado.ciclosSimulados << "  |  Instrucoes extrapoladas: "
+                  << resultado.instrucoesExtrapoladas << " de " << estado.estadoInstrucoes.size() << std::endl;
+    }
+    std::cout << std::string(70, '-') << std::endl;
+    std::cout << "\n== Simulacao Concluida em " << estado.clock_cycle << " ciclos"
+              << (resultado.extrapolou ? " (extrapolados)" : "") << ". ==" << std::endl;
+    if (estado.config.barramentosCDB > 0) {
+        std::cout << "Conflitos de CDB (escritas adiadas): " << estado.conflitosCDB << std::endl;
+    }
+}
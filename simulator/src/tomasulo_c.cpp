@@ -0,0 +1,76 @@
+#include "tomasulo.h"
+#include "simulador.hpp"
+
+struct tomasulo_simulador {
+    std::unique_ptr<Simulador<>> simulador;
+};
+
+namespace {
+
+tomasulo_simulador* embrulha(std::unique_ptr<Simulador<>> simulador) {
+    if (!simulador) return nullptr;
+    return new tomasulo_simulador{std::move(simulador)};
+}
+
+}
+
+extern "C" {
+
+tomasulo_simulador* tomasulo_cria(const char* arquivo) {
+    if (!arquivo) return nullptr;
+    return embrulha(Simulador<>::deArquivo(arquivo));
+}
+
+tomasulo_simulador* tomasulo_cria_de_texto(const char* conteudo) {
+    if (!conteudo) return nullptr;
+    return embrulha(Simulador<>::deTexto(conteudo));
+}
+
+void tomasulo_destroi(tomasulo_simulador* sim) {
+    delete sim;
+}
+
+int tomasulo_step(tomasulo_simulador* sim, int n) {
+    return sim ? sim->simulador->step(n) : 0;
+}
+
+int tomasulo_executa(tomasulo_simulador* sim) {
+    return sim && sim->simulador->executaAteTerminar() ? 1 : 0;
+}
+
+int tomasulo_terminou(const tomasulo_simulador* sim) {
+    return sim && sim->simulador->terminou() ? 1 : 0;
+}
+
+int tomasulo_ciclo(const tomasulo_simulador* sim) {
+    return sim ? sim->simulador->ciclo() : 0;
+}
+
+int tomasulo_num_instrucoes(const tomasulo_simulador* sim) {
+    return sim ? sim->simulador->numInstrucoes() : 0;
+}
+
+int tomasulo_tempos_instrucao(const tomasulo_simulador* sim, int indice, tomasulo_tempos* saida) {
+    if (!sim || !saida || indice < 0 || indice >= sim->simulador->numInstrucoes()) return -1;
+    TemposInstrucao tempos = sim->simulador->tempos(indice);
+    saida->issue = tempos.issue.value_or(-1);
+    saida->exe_completa = tempos.exeCompleta.value_or(-1);
+    saida->write = tempos.write.value_or(-1);
+    return 0;
+}
+
+void tomasulo_obtem_estatisticas(const tomasulo_simulador* sim, tomasulo_estatisticas* saida) {
+    if (!sim || !saida) return;
+    EstatisticasSimulacao stats = sim->simulador->estatisticas();
+    saida->ciclos = stats.ciclos;
+    saida->instrucoes = stats.instrucoes;
+    saida->emitidas = stats.emitidas;
+    saida->completas = stats.completas;
+    saida->ipc = stats.ipc;
+}
+
+int tomasulo_conflitos_cdb(const tomasulo_simulador* sim) {
+    return sim ? sim->simulador->estatisticas().conflitosCDB : 0;
+}
+
+}
@@ -1,4 +1,5 @@
 #include "utils.hpp"
+#include <exception>
 
 std::string trim(const std::string& str) {
     const std::string whitespace = " \t\n\r\f\v";
@@ -7,4 +8,19 @@ std::string trim(const std::string& str) {
         return "";
     size_t end = str.find_last_not_of(whitespace);
     return str.substr(start, end - start + 1);
-}
\ No newline at end of file
+}
+
+bool parseInteiro(const std::string& texto, long long minimo, long long maximo, long long& saida) {
+    size_t lidos = 0;
+    long long valor;
+    try {
+        valor = std::stoll(texto, &lidos);
+    } catch (const std::exception&) {
+        return false;
+    }
+    if (lidos != texto.size() || valor < minimo || valor > maximo) {
+        return false;
+    }
+    saida = valor;
+    return true;
+}
@@ -0,0 +1,49 @@
+/* Exercita a ABI C (include/tomasulo.h) a partir de C puro; a saída é conferida por tests/verifica.sh. */
+#include "tomasulo.h"
+#include <stdio.h>
+
+static void imprime(tomasulo_simulador* sim) {
+    tomasulo_estatisticas estatisticas;
+    tomasulo_tempos tempos;
+    int i;
+    for (i = 0; i < tomasulo_num_instrucoes(sim); ++i) {
+        tomasulo_tempos_instrucao(sim, i, &tempos);
+        printf("%d: issue %d, exe %d, write %d\n", i, tempos.issue, tempos.exe_completa, tempos.write);
+    }
+    tomasulo_obtem_estatisticas(sim, &estatisticas);
+    printf("ciclos %d, instrucoes %d, emitidas %d, completas %d, ipc %.3f, conflitos de CDB %d\n",
+           estatisticas.ciclos, estatisticas.instrucoes, estatisticas.emitidas, estatisticas.completas,
+           estatisticas.ipc, tomasulo_conflitos_cdb(sim));
+}
+
+int main(int argc, char* argv[]) {
+    tomasulo_simulador* sim;
+    tomasulo_tempos tempos;
+    int i, resultado;
+
+    if (tomasulo_cria("inexistente.txt") != NULL) printf("tomasulo_cria aceitou um arquivo inexistente\n");
+
+    for (i = 1; i < argc; ++i) { /* cada traço: alguns ciclos passo a passo, depois até o fim */
+        sim = tomasulo_cria(argv[i]);
+        if (sim == NULL) {
+            printf("%s: nao foi possivel ler\n", argv[i]);
+            return 1;
+        }
+        printf("== traco %d ==\n", i);
+        resultado = tomasulo_step(sim, 3); /* chamadas separadas: a ordem de avaliação dos argumentos do printf não é definida */
+        printf("step 3: %d ciclos, terminou %d\n", resultado, tomasulo_terminou(sim));
+        resultado = tomasulo_executa(sim);
+        printf("executa: %d, ciclo %d\n", resultado, tomasulo_ciclo(sim));
+        printf("indice invalido: %d\n", tomasulo_tempos_instrucao(sim, tomasulo_num_instrucoes(sim), &tempos));
+        imprime(sim);
+        tomasulo_destroi(sim);
+    }
+
+    sim = tomasulo_cria_de_texto("CONFIG_BEGIN\nCYCLES Add 2\nUNITS Add 1\nCONFIG_END\n"
+                                 "INSTRUCTIONS_BEGIN\nADDD F2 F4 F6\nADDD F8 F2 F2\nINSTRUCTIONS_END\n");
+    printf("== texto ==\n");
+    tomasulo_executa(sim);
+    imprime(sim);
+    tomasulo_destroi(sim);
+    return 0;
+}
@@ -0,0 +1,84 @@
+#!/bin/sh
+# Confere a saída do simulador com as saídas esperadas em tests/<caso>.esperado.
+# Uso: tests/verifica.sh <simulador> [confere | atualiza] [programa da ABI C]
+# Com "atualiza", regrava os arquivos .esperado em vez de comparar. O programa da ABI C (tests/capi.c,
+# compilado pelo make test) é opcional; sem ele o caso capi é pulado.
+
+SIMULADOR=${1:-./simulator}
+MODO=${2:-confere}
+CAPI=$3
+PROGRAMA=$SIMULADOR
+DIR=$(dirname "$0")
+falhas=0
+total=0
+
+# modo run: guarda só o último ciclo (tabelas finais) e o resumo, para os arquivos não crescerem com o traço
+ultimo_ciclo() {
+    awk '/CLOCK CYCLE:/ { saida = "" } { saida = saida $0 "\n" } END { printf "%s", saida }'
+}
+
+# modos com relógio de parede: mascara tempos e número de threads, que variam entre máquinas
+sem_tempos() {
+    sed -e 's/Threads: [0-9]*/Threads: _/' -e 's/\(Tempo[^:|]*\): [0-9.]* s/\1: _ s/g'
+}
+
+executa() { # executa <caso> <argumentos completos do simulador...>
+    caso=$1
+    shift
+    total=$((total + 1))
+    obtido=$(mktemp)
+    modo_simulador=$2
+    [ "$1" = "smt" ] && modo_simulador=smt
+    case "$modo_simulador" in
+        run) "$PROGRAMA" "$@" < /dev/null 2>&1 | ultimo_ciclo > "$obtido" ;;
+        intervals | tune) "$PROGRAMA" "$@" < /dev/null 2>&1 | sem_tempos > "$obtido" ;;
+        *) "$PROGRAMA" "$@" < /dev/null > "$obtido" 2>&1 ;;
+    esac
+
+    if [ "$MODO" = "atualiza" ]; then
+        mv "$obtido" "$DIR/$caso.esperado"
+        echo "ATUALIZADO $caso"
+        return
+    fi
+    if diff -u "$DIR/$caso.esperado" "$obtido" > "$obtido.diff"; then
+        echo "OK    $caso"
+    else
+        echo "FALHA $caso"
+        cat "$obtido.diff"
+        falhas=$((falhas + 1))
+    fi
+    rm -f "$obtido" "$obtido.diff"
+}
+
+verifica() { # verifica <caso> <argumentos do simulador...>: roda sobre tests/<caso>.txt
+    caso=$1
+    shift
+    executa "$caso" "$DIR/$caso.txt" "$@"
+}
+
+verifica escalar run                    # traço base do input.txt
+verifica vetorial_sem_encadeamento run  # exemplo vetorial do README: 167 ciclos
+verifica vetorial_encadeamento run      # o mesmo com CHAINING 1: 71 ciclos
+verifica cdb1 run                       # CDB 1: escritas adiadas por disputa do barramento
+verifica cdb1_store run                 # CDB 1: SD não difunde valor e não ocupa o barramento
+verifica laco steady ref                # regime extrapolado contra a simulação completa (Divergencias: 0)
+executa laco_intervalos "$DIR/laco.txt" intervals 3 4 ref  # 3 intervalos com 4 instruções de aquecimento contra a referência
+executa escalar_analise "$DIR/escalar.txt" analyze  # caminho crítico 1 -> 2 -> 4 e limites por unidade
+executa vetorial_encadeamento_analise "$DIR/vetorial_encadeamento.txt" analyze  # encadeamento: limite de 70 contra 71 simulados
+executa cdb1_analise "$DIR/cdb1.txt" analyze  # limite de escrita com CDB 1
+executa smt_rr smt rr "$DIR/escalar.txt" "$DIR/smt_thread1.txt"  # duas threads; a segunda herda a configuração
+executa smt_icount smt icount "$DIR/escalar.txt" "$DIR/smt_thread1.txt"
+executa smt_maquina_diferente smt rr "$DIR/escalar.txt" "$DIR/cdb1.txt"  # CDB 1 só no segundo traço: recusado
+executa escalar_ajuste "$DIR/escalar.txt" tune 3 4 7  # semente fixa: mesma fronteira de Pareto e mesmos acertos no cache
+
+if [ -n "$CAPI" ]; then # a mesma biblioteca vista de um programa em C puro
+    PROGRAMA=$CAPI
+    executa capi "$DIR/escalar.txt" "$DIR/cdb1.txt"  # step/executa, tempos por instrução, estatísticas e conflitos de CDB
+    PROGRAMA=$SIMULADOR
+else
+    echo "PULADO capi (sem o programa da ABI C)"
+fi
+
+[ "$MODO" = "atualiza" ] && exit 0
+echo "$((total - falhas)) de $total casos conferem"
+[ "$falhas" -eq 0 ]